@@ -0,0 +1,218 @@
+/**
+ * Part of Nova C++ Library.
+ *
+ * Batch decoding of bit-packed records into columns.
+ *
+ * The fields of a record are described once with their bit extents, then a
+ * batch of fixed stride records is decoded field by field, each field into
+ * its own column (structure of arrays):
+ *
+ * ```cpp
+ * using namespace nova::units::literals;
+ *
+ * constexpr auto header = nova::bit_field_plan{
+ *     nova::bit_field{ "version", nova::extent{ 0_bit, 4_bit } },
+ *     nova::bit_field{ "flags",   nova::extent{ 4_bit, 12_bit } },
+ *     nova::bit_field{ "length",  nova::extent{ 2_byte, 2_byte } },
+ * };
+ *
+ * const auto columns = header.decode_columns(view, pos, count);
+ * const auto& lengths = columns[header.index_of("length")];
+ * ```
+ *
+ * The bounds are checked once for the whole batch. Every value is extracted
+ * from a single 64-bit big endian load with two shifts, the same as
+ * `data_view::as_number_bit_packed()` would return.
+ */
+
+#pragma once
+
+#include <libnova/data.hpp>
+#include <libnova/error.hpp>
+#include <libnova/std_extensions.hpp>
+#include <libnova/types.hpp>
+#include <libnova/units.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace nova {
+
+/**
+ * @brief   A named bit-packed field of a record.
+ */
+struct bit_field {
+    std::string_view name;
+
+    /**
+     * Position and length in bits.
+     */
+    std::size_t pos = 0;
+    std::size_t length = 0;
+
+    /**
+     * @param ex    Position and length as bits or bytes, e.g.,
+     *              `extent{ 1_byte, 2_bit }`.
+     *
+     * @throws  if the length is zero or more than 64 bits.
+     */
+    template <typename R1, typename R2>
+    constexpr bit_field(
+        std::string_view name_,
+        extent<units::measure<units::data_volume, long long, R1>, units::measure<units::data_volume, long long, R2>> ex
+    )
+        : name(name_)
+        , pos(static_cast<std::size_t>(units::measure_cast<units::bits>(ex.pos).count()))
+        , length(static_cast<std::size_t>(units::measure_cast<units::bits>(ex.len).count()))
+    {
+        if (length == 0 or length > 64) {
+            throw exception("Invalid bit field length: {} bits", length);
+        }
+    }
+
+    [[nodiscard]] constexpr auto end() const -> std::size_t { return pos + length; }
+};
+
+/**
+ * @brief   Decode plan of a record made of bit fields.
+ */
+template <std::size_t N>
+class bit_field_plan {
+public:
+    static constexpr auto npos = std::numeric_limits<std::size_t>::max();
+
+    template <std::same_as<bit_field> ...Fields>
+        requires (sizeof...(Fields) == N)
+    constexpr explicit bit_field_plan(const Fields& ...fields)
+        : m_fields{ fields... }
+    {}
+
+    [[nodiscard]] constexpr auto fields() const -> const std::array<bit_field, N>& { return m_fields; }
+
+    /**
+     * @brief   Index of the field (and its column) called `name`, or `npos`.
+     */
+    [[nodiscard]] constexpr auto index_of(std::string_view name) const -> std::size_t {
+        const auto it = std::ranges::find(m_fields, name, &bit_field::name);
+        return it == m_fields.end() ? npos : static_cast<std::size_t>(std::distance(m_fields.begin(), it));
+    }
+
+    /**
+     * @brief   Size of a record in bytes, up to the end of the last field.
+     */
+    [[nodiscard]] constexpr auto record_size() const -> std::size_t {
+        std::size_t end = 0;
+        for (const auto& x : m_fields) {
+            end = std::max(end, x.end());
+        }
+        return (end + 7) / 8;
+    }
+
+    /**
+     * @brief   Decode `count` records from `pos` (in bytes), `stride` bytes
+     *          apart, writing the fields into their columns.
+     *
+     * @param columns   One column for each field, in the order of the fields,
+     *                  of at least `count` elements.
+     *
+     * @throws  if the records are out of bounds.
+     */
+    template <std::unsigned_integral T>
+    void decode(
+        data_view data,
+        std::size_t pos,
+        std::size_t count,
+        std::size_t stride,
+        const std::array<std::span<T>, N>& columns
+    ) const {
+        nova_assert(stride >= record_size());
+        nova_assert(count == 0 or stride <= std::numeric_limits<std::size_t>::max() / count);
+        if (count == 0) {
+            return;
+        }
+        const auto records = data.checked(pos, (count - 1) * stride + record_size());
+
+        for (std::size_t f = 0; f < N; ++f) {
+            nova_assert(columns[f].size() >= count);
+            nova_assert(m_fields[f].length <= sizeof(T) * 8);
+            decode_field(records, count, stride, m_fields[f], columns[f].data());
+        }
+    }
+
+    /**
+     * @brief   Decode `count` records into newly allocated columns.
+     */
+    template <std::unsigned_integral T = std::uint64_t>
+    [[nodiscard]] auto decode_columns(
+        data_view data,
+        std::size_t pos,
+        std::size_t count,
+        std::size_t stride = 0
+    ) const -> std::array<std::vector<T>, N> {
+        auto ret = std::array<std::vector<T>, N>{ };
+        auto columns = std::array<std::span<T>, N>{ };
+        for (std::size_t f = 0; f < N; ++f) {
+            ret[f].resize(count);
+            columns[f] = ret[f];
+        }
+        decode(data, pos, count, stride == 0 ? record_size() : stride, columns);
+        return ret;
+    }
+
+private:
+    std::array<bit_field, N> m_fields;
+
+    /**
+     * @brief   Decode a single field of every record.
+     *
+     * While there are 8 bytes to load from the first byte of the field, and
+     * the field fits into the loaded word, it is two shifts; the rest goes
+     * through `as_number_bit_packed()`.
+     */
+    template <typename T>
+    static void decode_field(
+        const detail::data_view<endian::big, false>& records,
+        std::size_t count,
+        std::size_t stride,
+        const bit_field& field,
+        T* out
+    ) {
+        const auto first_byte = field.pos / 8;
+        const auto shift = field.pos % 8;
+        const auto drop = 64 - field.length;
+
+        std::size_t fast = 0;
+        if (shift + field.length <= 64 and first_byte + sizeof(std::uint64_t) <= records.size()) {
+            fast = std::min(count, (records.size() - sizeof(std::uint64_t) - first_byte) / stride + 1);
+        }
+
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const auto* src = std::next(records.ptr(), static_cast<std::ptrdiff_t>(first_byte));
+        for (std::size_t i = 0; i < fast; ++i) {
+            auto word = std::uint64_t{ };
+            std::memcpy(&word, src + i * stride, sizeof(word));
+            if constexpr (endian::native != endian::big) {
+                word = nova::byteswap(word);
+            }
+            out[i] = static_cast<T>((word << shift) >> drop);
+        }
+
+        for (std::size_t i = fast; i < count; ++i) {
+            out[i] = static_cast<T>(records.as_number_bit_packed<std::uint64_t>(i * stride * 8 + field.pos, field.length));
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+};
+
+template <std::same_as<bit_field> ...Fields>
+bit_field_plan(const Fields& ...) -> bit_field_plan<sizeof...(Fields)>;
+
+} // namespace nova
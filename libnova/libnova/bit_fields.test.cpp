@@ -0,0 +1,97 @@
+#define NOVA_RUNTIME_ASSERTIONS
+
+#include <libnova/bit_fields.hpp>
+#include <libnova/data.hpp>
+#include <libnova/test_utils.hpp>
+#include <libnova/units.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+using namespace nova::literals;
+using namespace nova::units::literals;
+
+namespace {
+
+constexpr auto Header = nova::bit_field_plan{
+    nova::bit_field{ "version", nova::extent{ 0_bit, 4_bit } },
+    nova::bit_field{ "flags",   nova::extent{ 4_bit, 12_bit } },
+    nova::bit_field{ "length",  nova::extent{ 2_byte, 2_byte } },
+    nova::bit_field{ "odd",     nova::extent{ 1_byte, 3_bit } },
+};
+
+} // namespace
+
+TEST(BitFieldPlan, Describe) {
+    static_assert(Header.record_size() == 4);
+    static_assert(Header.index_of("length") == 2);
+    static_assert(Header.index_of("unknown") == decltype(Header)::npos);
+    static_assert(Header.fields()[3].pos == 8);
+    static_assert(Header.fields()[3].length == 3);
+
+    EXPECT_THROWN_MESSAGE(nova::bit_field("x", nova::extent{ 0_bit, 65_bit }), "Invalid bit field length: 65 bits");
+}
+
+TEST(BitFieldPlan, DecodeColumns) {
+    const auto data = "\x12\x34\x00\x05" "\xAB\xCD\x01\x00"_data;
+    const auto columns = Header.decode_columns(data, 0, 2);
+
+    EXPECT_THAT(columns[0], testing::ElementsAre(0x1, 0xA));
+    EXPECT_THAT(columns[1], testing::ElementsAre(0x234, 0xBCD));
+    EXPECT_THAT(columns[2], testing::ElementsAre(5, 256));
+    EXPECT_THAT(columns[3], testing::ElementsAre(0b001, 0b110));
+}
+
+TEST(BitFieldPlan, SameAsBitPackedDataView) {
+    static constexpr auto plan = nova::bit_field_plan{
+        nova::bit_field{ "a", nova::extent{ 3_bit, 7_bit } },
+        nova::bit_field{ "b", nova::extent{ 1_byte, 64_bit } },
+        nova::bit_field{ "c", nova::extent{ 77_bit, 61_bit } },
+        nova::bit_field{ "d", nova::extent{ 16_byte, 1_bit } },
+    };
+    constexpr std::size_t Stride = 20;
+    constexpr std::size_t Count = 50;
+
+    // The last records are shorter than 8 bytes from some fields.
+    const auto data = sample_data(3 + (Count - 1) * Stride + plan.record_size());
+    const auto view = nova::data_view(data);
+    const auto columns = plan.decode_columns(view, 3, Count, Stride);
+
+    for (std::size_t i = 0; i < Count; ++i) {
+        for (std::size_t f = 0; f < plan.fields().size(); ++f) {
+            const auto& field = plan.fields()[f];
+            EXPECT_EQ(columns[f][i], view.as_number_bit_packed<std::uint64_t>((3 + i * Stride) * 8 + field.pos, field.length))
+                << "Record=" << i << " Field=" << field.name;
+        }
+    }
+}
+
+TEST(BitFieldPlan, DecodeIntoSpans) {
+    const auto data = "\x12\x34\x00\x05" "\xAB\xCD\x01\x00"_data;
+    auto versions = std::array<std::uint16_t, 1>{ };
+    auto flags = std::array<std::uint16_t, 2>{ };
+    auto lengths = std::array<std::uint16_t, 2>{ };
+    auto odd = std::array<std::uint16_t, 2>{ };
+
+    static constexpr auto plan = nova::bit_field_plan{
+        nova::bit_field{ "flags",   nova::extent{ 4_bit, 12_bit } },
+        nova::bit_field{ "length",  nova::extent{ 2_byte, 2_byte } },
+    };
+    plan.decode(data, 0, 2, 4, std::to_array<std::span<std::uint16_t>>({ flags, lengths }));
+    EXPECT_THAT(flags, testing::ElementsAre(0x234, 0xBCD));
+    EXPECT_THAT(lengths, testing::ElementsAre(5, 256));
+
+    EXPECT_ASSERTION_FAIL(Header.decode(data, 0, 2, 4, std::to_array<std::span<std::uint16_t>>({ versions, flags, lengths, odd })));
+}
+
+TEST(BitFieldPlan, OutOfBounds) {
+    const auto data = "\x12\x34\x00\x05" "\xAB\xCD\x01"_data;
+    EXPECT_THROWN_MESSAGE(std::ignore = Header.decode_columns(data, 0, 2), "Out of bounds access: Pos=0 Len=8 End=8 \\(Size=7\\)");
+    EXPECT_ASSERTION_FAIL(std::ignore = Header.decode_columns(data, 0, 2, 3));
+    EXPECT_TRUE(Header.decode_columns(data, 0, 0)[0].empty());
+}
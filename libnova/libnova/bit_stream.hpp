@@ -0,0 +1,531 @@
+/**
+ * Part of Nova C++ Library.
+ *
+ * Sequential access to bit-packed data.
+ *
+ * - `bit_reader` for reading fields of arbitrary bit length from a `data_view`.
+ * - `bit_writer` for writing them, standalone or into a `serializer_context`.
+ *
+ * Bits are consumed in either MSB-first (network order, as in
+ * `data_view::as_number_bit_packed`) or LSB-first order (e.g., DEFLATE).
+ *
+ * ```cpp
+ * auto reader = nova::bit_reader{ view };
+ * const auto version = reader.read<std::uint8_t>(3);
+ * const auto length  = reader.read<std::uint16_t>(13);
+ * reader.skip(1_byte);
+ *
+ * auto writer = nova::bit_writer{ };
+ * writer.write(version, 3);
+ * writer.write(length, 13);
+ * writer.pad(1_byte);
+ * const auto data = writer.data();
+ * ```
+ */
+
+#pragma once
+
+#include <libnova/data.hpp>
+#include <libnova/error.hpp>
+#include <libnova/units.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace nova {
+
+/**
+ * @brief   The order in which the bits of a byte are consumed or produced.
+ */
+enum class bit_order : std::uint8_t {
+    msb_first,
+    lsb_first,
+};
+
+namespace detail {
+
+    /**
+     * @brief   Number of bits that are always available in the bit buffer after
+     *          a refill (unless the data is exhausted).
+     */
+    inline constexpr std::size_t BitBufferCapacity = 56;
+
+    /**
+     * @brief   Byte order of the words that hold the bits in the given order.
+     */
+    template <bit_order Order>
+    inline constexpr auto bit_order_endian = Order == bit_order::msb_first ? endian::big : endian::little;
+
+} // namespace detail
+
+/**
+ * @brief   Sequential reader of bit-packed data.
+ *
+ * Bits are loaded into a 64-bit accumulator, up to 8 bytes at a time, so a
+ * read is a couple of shifts most of the time.
+ *
+ * Values are assembled in the given bit order, i.e., with `msb_first` the first
+ * bit read is the most significant bit of the value; with `lsb_first` it is
+ * the least significant bit.
+ *
+ * NOTE: it is a non-owning view, it is the caller's responsibility to make sure
+ * the `bit_reader` does not outlive the data it refers to.
+ *
+ * @throws  Reading member functions throw if `RuntimeBoundCheck` is turned on,
+ *          else calls to `assert` (debug mode check)
+ */
+template <bit_order Order = bit_order::msb_first, bool RuntimeBoundCheck = true>
+class bit_reader {
+    static constexpr std::size_t Byte = 8;
+
+    template <typename R>
+    using Measure = units::measure<units::data_volume, long long, R>;
+
+    using view_type = detail::data_view<detail::bit_order_endian<Order>, false>;
+
+public:
+    template <endian Endianness, bool BoundCheck>
+    [[nodiscard]] bit_reader(detail::data_view<Endianness, BoundCheck> data)
+        : m_data(data.ptr(), data.size())
+    {}
+
+    /**
+     * @brief   Read `length` bits and advance the position.
+     */
+    template <std::unsigned_integral T = std::uint64_t>
+    [[nodiscard]] auto read(std::size_t length) -> T {
+        nova_assert(length <= sizeof(T) * Byte);
+        boundary_check(length);
+
+        if (length <= detail::BitBufferCapacity) {
+            return static_cast<T>(take(length));
+        }
+
+        // Only 64 bit values reach here; read them in two parts.
+        const auto first = take(length - detail::BitBufferCapacity);
+        const auto second = take(detail::BitBufferCapacity);
+
+        if constexpr (Order == bit_order::msb_first) {
+            return static_cast<T>(first << detail::BitBufferCapacity | second);
+        }
+        else {
+            return static_cast<T>(second << (length - detail::BitBufferCapacity) | first);
+        }
+    }
+
+    template <std::unsigned_integral T = std::uint64_t, typename R>
+    [[nodiscard]] auto read(Measure<R> length) -> T {
+        return read<T>(to_bits(length));
+    }
+
+    /**
+     * @brief   Read `length` bits without advancing the position.
+     *
+     * At most 56 bits can be peeked.
+     */
+    template <std::unsigned_integral T = std::uint64_t>
+    [[nodiscard]] auto peek(std::size_t length) -> T {
+        nova_assert(length <= sizeof(T) * Byte);
+        nova_assert(length <= detail::BitBufferCapacity);
+        boundary_check(length);
+
+        if (m_count < length) {
+            refill();
+        }
+        return static_cast<T>(extract(length));
+    }
+
+    /**
+     * @brief   Advance the position by `length` bits.
+     */
+    void skip(std::size_t length) {
+        boundary_check(length);
+
+        if (length <= m_count) {
+            consume(length);
+        }
+        else {
+            seek(pos() + length);
+        }
+    }
+
+    template <typename R>
+    void skip(Measure<R> length) {
+        skip(to_bits(length));
+    }
+
+    /**
+     * @brief   Jump to position `pos` given in bits from the beginning.
+     */
+    void seek(std::size_t pos) {
+        if constexpr (RuntimeBoundCheck) {
+            if (pos > size()) {
+                throw exception(
+                    "Out of bounds access: {} (bits)",
+                    detail::data_cursor{ pos, 0, size() }
+                );
+            }
+        }
+        else {
+            nova_assert(pos <= size());
+        }
+
+        m_next = pos / Byte;
+        m_buffer = 0;
+        m_count = 0;
+
+        if (const auto offset = pos % Byte; offset > 0) {
+            refill();
+            consume(offset);
+        }
+    }
+
+    template <typename R>
+    void seek(Measure<R> pos) {
+        seek(to_bits(pos));
+    }
+
+    /**
+     * @brief   Skip the rest of the current byte.
+     */
+    void align() {
+        if (const auto offset = pos() % Byte; offset > 0) {
+            skip(Byte - offset);
+        }
+    }
+
+    /**
+     * @brief   Position in bits from the beginning.
+     */
+    [[nodiscard]] auto pos() const -> std::size_t {
+        return m_next * Byte - m_count;
+    }
+
+    /**
+     * @brief   Size of the data in bits.
+     */
+    [[nodiscard]] auto size() const -> std::size_t {
+        return m_data.size() * Byte;
+    }
+
+    [[nodiscard]] auto remaining() const -> std::size_t { return size() - pos(); }
+    [[nodiscard]] auto empty()     const -> bool        { return remaining() == 0; }
+
+private:
+    view_type m_data;
+
+    /**
+     * Next byte to be loaded into the buffer.
+     */
+    std::size_t m_next = 0;
+
+    /**
+     * Bits that are not yet consumed. With `msb_first` the next bit is the
+     * most significant one, with `lsb_first` it is the least significant one.
+     *
+     * Bits beyond `m_count` may be present from a word load; they are always
+     * the following bits of the data.
+     */
+    std::uint64_t m_buffer = 0;
+    std::size_t m_count = 0;
+
+    template <typename R>
+    [[nodiscard]] static auto to_bits(Measure<R> x) -> std::size_t {
+        return static_cast<std::size_t>(units::measure_cast<units::bits>(x).count());
+    }
+
+    /**
+     * @brief   Fill the buffer to at least 56 bits, if there is enough data.
+     *
+     * Loads a whole word and advances by the number of complete bytes that
+     * fit into the buffer. Falls back to loading byte by byte at the end.
+     */
+    void refill() {
+        if (m_data.size() >= sizeof(std::uint64_t) and m_next <= m_data.size() - sizeof(std::uint64_t)) {
+            const auto word = m_data.template as_number<std::uint64_t>(m_next);
+            if constexpr (Order == bit_order::msb_first) {
+                m_buffer |= word >> m_count;
+            }
+            else {
+                m_buffer |= word << m_count;
+            }
+            m_next += (63 - m_count) / Byte;
+            m_count |= detail::BitBufferCapacity;
+            return;
+        }
+
+        while (m_count < detail::BitBufferCapacity and m_next < m_data.size()) {
+            const auto byte = std::to_integer<std::uint64_t>(m_data.span()[m_next]);
+            if constexpr (Order == bit_order::msb_first) {
+                m_buffer |= byte << (detail::BitBufferCapacity - m_count);
+            }
+            else {
+                m_buffer |= byte << m_count;
+            }
+            ++m_next;
+            m_count += Byte;
+        }
+    }
+
+    [[nodiscard]] auto extract(std::size_t length) const -> std::uint64_t {
+        if (length == 0) {
+            return 0;
+        }
+        if constexpr (Order == bit_order::msb_first) {
+            return m_buffer >> (64 - length);
+        }
+        else {
+            return m_buffer & ((std::uint64_t{ 1 } << length) - 1);
+        }
+    }
+
+    void consume(std::size_t length) {
+        if constexpr (Order == bit_order::msb_first) {
+            m_buffer <<= length;
+        }
+        else {
+            m_buffer >>= length;
+        }
+        m_count -= length;
+    }
+
+    /**
+     * @brief   Read at most 56 bits.
+     */
+    [[nodiscard]] auto take(std::size_t length) -> std::uint64_t {
+        if (m_count < length) {
+            refill();
+        }
+        const auto ret = extract(length);
+        consume(length);
+        return ret;
+    }
+
+    void boundary_check(std::size_t length) const {
+        if constexpr (RuntimeBoundCheck) {
+            if (remaining() < length) {
+                throw exception(
+                    "Out of bounds access: {} (bits)",
+                    detail::data_cursor{ pos(), length, size() }
+                );
+            }
+        }
+        else {
+            nova_assert(length <= remaining());
+        }
+    }
+
+};
+
+template <endian Endianness, bool BoundCheck>
+bit_reader(detail::data_view<Endianness, BoundCheck>) -> bit_reader<>;
+
+/**
+ * @brief   Sequential writer of bit-packed data, the counterpart of `bit_reader`.
+ *
+ * Bits are accumulated in a 64-bit register which is written out as a whole
+ * word when it is full.
+ *
+ * The bytes are written into a serializer context: either into an own one
+ * (standalone), or into an existing one given by reference.
+ *
+ * ```cpp
+ * auto ser = nova::serializer_context{ };
+ * ser(message_type);
+ *
+ * auto writer = nova::bit_writer{ ser };
+ * writer.write(flags, 5);
+ * writer.write(length, 11);
+ * writer.finish();
+ *
+ * ser(payload);
+ * ```
+ *
+ * NOTE: `finish()` must be called to write out the last (partial) word.
+ *
+ * @tparam Context  A `serializer_context` owned by the writer, or a reference
+ *                  to one.
+ */
+template <bit_order Order = bit_order::msb_first, typename Context = serializer_context>
+class bit_writer {
+    static constexpr std::size_t Byte = 8;
+    static constexpr std::size_t WordBits = 64;
+
+    template <typename R>
+    using Measure = units::measure<units::data_volume, long long, R>;
+
+public:
+    /**
+     * @brief   Standalone writer with its own serializer context.
+     */
+    [[nodiscard]] bit_writer(std::size_t size = 1) requires (not std::is_reference_v<Context>)
+        : m_context(size)
+    {}
+
+    /**
+     * @brief   Writer appending to an existing serializer context.
+     */
+    [[nodiscard]] bit_writer(Context context) requires std::is_reference_v<Context>
+        : m_context(context)
+    {}
+
+    /**
+     * @brief   Write the lowest `length` bits of `value`.
+     *
+     * @precondition    `value` must fit into `length` bits.
+     */
+    void write(std::uint64_t value, std::size_t length) {
+        nova_assert(length <= WordBits);
+        nova_assert(length == WordBits or (value >> length) == 0);
+
+        if (length == 0) {
+            return;
+        }
+
+        if (m_count + length <= WordBits) {
+            if constexpr (Order == bit_order::msb_first) {
+                m_buffer |= value << (WordBits - m_count - length);
+            }
+            else {
+                m_buffer |= value << m_count;
+            }
+            m_count += length;
+
+            if (m_count == WordBits) {
+                flush_word();
+            }
+            return;
+        }
+
+        // Spillover to the next word.
+        const auto head = WordBits - m_count;
+        const auto tail = length - head;
+
+        if constexpr (Order == bit_order::msb_first) {
+            m_buffer |= value >> tail;
+            flush_word();
+            m_buffer = value << (WordBits - tail);
+        }
+        else {
+            m_buffer |= value << m_count;
+            flush_word();
+            m_buffer = value >> head;
+        }
+        m_count = tail;
+    }
+
+    template <typename R>
+    void write(std::uint64_t value, Measure<R> length) {
+        write(value, to_bits(length));
+    }
+
+    /**
+     * @brief   Write `length` zero bits.
+     */
+    void pad(std::size_t length) {
+        for (; length > WordBits; length -= WordBits) {
+            write(0, WordBits);
+        }
+        write(0, length);
+    }
+
+    template <typename R>
+    void pad(Measure<R> length) {
+        pad(to_bits(length));
+    }
+
+    /**
+     * @brief   Pad with zero bits up to the next byte boundary.
+     */
+    void align() {
+        if (const auto offset = pos() % Byte; offset > 0) {
+            pad(Byte - offset);
+        }
+    }
+
+    /**
+     * @brief   Pad to the next byte boundary and write out all pending bytes.
+     *
+     * The writer can be used afterwards.
+     */
+    void finish() {
+        align();
+
+        if (m_count > 0) {
+            const auto word = word_bytes();
+            m_context(data_view{ word.data(), m_count / Byte });
+            m_written += m_count / Byte;
+            m_buffer = 0;
+            m_count = 0;
+        }
+    }
+
+    /**
+     * @brief   Start a new bit stream keeping the allocated buffer of the own
+     *          serializer context. Pending bits are dropped.
+     */
+    void reset() requires (not std::is_reference_v<Context>) {
+        m_context.reset();
+        m_buffer = 0;
+        m_count = 0;
+        m_written = 0;
+    }
+
+    /**
+     * @brief   Number of bits written.
+     */
+    [[nodiscard]] auto pos() const -> std::size_t {
+        return m_written * Byte + m_count;
+    }
+
+    [[nodiscard]] auto context() -> std::remove_reference_t<Context>& {
+        return m_context;
+    }
+
+    /**
+     * @brief   Finish writing and return a copy of the serialized data.
+     */
+    [[nodiscard]] auto data() -> bytes requires (not std::is_reference_v<Context>) {
+        finish();
+        return m_context.data();
+    }
+
+private:
+    Context m_context;
+    std::uint64_t m_buffer = 0;
+    std::size_t m_count = 0;
+
+    /**
+     * Number of bytes written into the context.
+     */
+    std::size_t m_written = 0;
+
+    template <typename R>
+    [[nodiscard]] static auto to_bits(Measure<R> x) -> std::size_t {
+        return static_cast<std::size_t>(units::measure_cast<units::bits>(x).count());
+    }
+
+    [[nodiscard]] auto word_bytes() const -> std::array<std::byte, sizeof(std::uint64_t)> {
+        auto ret = std::array<std::byte, sizeof(std::uint64_t)>{ };
+        detail::store_numbers<detail::bit_order_endian<Order>>(ret.data(), &m_buffer, 1);
+        return ret;
+    }
+
+    void flush_word() {
+        const auto word = word_bytes();
+        m_context(data_view{ word });
+        m_written += sizeof(std::uint64_t);
+        m_buffer = 0;
+        m_count = 0;
+    }
+
+};
+
+template <endian Endianness, typename Allocator>
+bit_writer(detail::serializer_context<Endianness, Allocator>&) -> bit_writer<bit_order::msb_first, detail::serializer_context<Endianness, Allocator>&>;
+
+} // namespace nova
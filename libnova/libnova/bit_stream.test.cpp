@@ -0,0 +1,230 @@
+#define NOVA_RUNTIME_ASSERTIONS
+
+#include <libnova/bit_stream.hpp>
+#include <libnova/data.hpp>
+#include <libnova/test_utils.hpp>
+#include <libnova/units.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace nova::units::literals;
+
+TEST(BitReader, MsbFirst) {
+    static constexpr auto data = std::to_array<unsigned char>({
+        0b1100'0001,
+        0b1010'0011,
+    });
+
+    auto reader = nova::bit_reader{ nova::data_view(data) };
+    EXPECT_EQ(reader.read(1), 1);
+    EXPECT_EQ(reader.read(2), 2);
+    EXPECT_EQ(reader.read(9), 0b0'0001'1010);
+    EXPECT_EQ(reader.pos(), 12);
+    EXPECT_EQ(reader.read<std::uint8_t>(4), 0b0011);
+    EXPECT_TRUE(reader.empty());
+}
+
+TEST(BitReader, LsbFirst) {
+    static constexpr auto data = std::to_array<unsigned char>({
+        0b1100'0001,
+        0b1010'0011,
+    });
+
+    auto reader = nova::bit_reader<nova::bit_order::lsb_first>{ nova::data_view(data) };
+    EXPECT_EQ(reader.read(1), 1);
+    EXPECT_EQ(reader.read(2), 0);
+    EXPECT_EQ(reader.read(9), 0b0'0111'1000);
+    EXPECT_EQ(reader.read<std::uint8_t>(4), 0b1010);
+    EXPECT_TRUE(reader.empty());
+}
+
+TEST(BitReader, SameAsBitPackedDataView) {
+    const auto data = sample_data(64);
+    const auto view = nova::data_view(data);
+    auto reader = nova::bit_reader{ view };
+
+    std::size_t pos = 0;
+    for (std::size_t length = 3; pos + length <= view.size() * 8; length = length % 13 + 3) {
+        EXPECT_EQ(reader.read(length), view.as_number_bit_packed(pos, length)) << "Pos=" << pos;
+        pos += length;
+    }
+}
+
+TEST(BitReader, Read64Bits) {
+    const auto data = sample_data(24);
+    const auto view = nova::data_view(data);
+    const auto view_le = nova::data_view_le(data);
+
+    auto msb = nova::bit_reader{ view };
+    auto lsb = nova::bit_reader<nova::bit_order::lsb_first>{ view };
+    EXPECT_EQ(msb.read(64), view.as_number<std::uint64_t>(0));
+    EXPECT_EQ(lsb.read(64), view_le.as_number<std::uint64_t>(0));
+
+    std::ignore = msb.read(4);
+    EXPECT_EQ(msb.read(64), view.as_number_bit_packed<std::uint64_t>(68, 64));
+}
+
+TEST(BitReader, Peek) {
+    static constexpr auto data = std::to_array<unsigned char>({ 0b1100'0001 });
+
+    auto reader = nova::bit_reader{ nova::data_view(data) };
+    EXPECT_EQ(reader.peek(2), 3);
+    EXPECT_EQ(reader.peek(3), 6);
+    EXPECT_EQ(reader.pos(), 0);
+    EXPECT_EQ(reader.read(3), 6);
+}
+
+TEST(BitReader, SkipSeekAlign) {
+    static constexpr auto data = std::to_array<unsigned char>({ 0x01, 0x02, 0x03, 0x04 });
+
+    auto reader = nova::bit_reader{ nova::data_view(data) };
+    reader.skip(1_byte);
+    EXPECT_EQ(reader.read(8), 0x02);
+
+    reader.skip(3_bit);
+    reader.align();
+    EXPECT_EQ(reader.pos(), 24);
+    EXPECT_EQ(reader.read(8), 0x04);
+
+    reader.seek(1_byte);
+    EXPECT_EQ(reader.read(4_bit), 0);
+    EXPECT_EQ(reader.read(4_bit), 2);
+
+    reader.seek(13);
+    EXPECT_EQ(reader.read(3), 2);
+
+    reader.skip(3_bit);
+    reader.seek(0_bit);
+    EXPECT_EQ(reader.read(16), 0x0102);
+}
+
+TEST(BitReader, SkipFullBufferAtTheEnd) {
+    static constexpr auto data = std::to_array<unsigned char>({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 });
+
+    auto msb = nova::bit_reader{ nova::data_view(data) };
+    EXPECT_EQ(msb.read(8), 0x01);
+    EXPECT_EQ(msb.peek(56), 0x02'0304'0506'0708);
+    msb.skip(64);
+    EXPECT_EQ(msb.read(32), 0x0A0B'0C0D);
+
+    auto lsb = nova::bit_reader<nova::bit_order::lsb_first>{ nova::data_view(data) };
+    EXPECT_EQ(lsb.read(8), 0x01);
+    EXPECT_EQ(lsb.peek(56), 0x08'0706'0504'0302);
+    lsb.skip(64);
+    EXPECT_EQ(lsb.read(32), 0x0D0C'0B0A);
+}
+
+TEST(BitReader, ErrorOutOfBounds) {
+    static constexpr auto data = std::to_array<unsigned char>({ 0b1100'0001 });
+
+    EXPECT_THAT(
+        []{
+            auto reader = nova::bit_reader{ nova::data_view(data) };
+            std::ignore = reader.read(3);
+            std::ignore = reader.read(6);
+        },
+        testing::ThrowsMessage<nova::exception>(
+            testing::HasSubstr("Out of bounds access: Pos=3 Len=6 End=9 (Size=8) (bits)")
+        )
+    );
+
+    auto reader = nova::bit_reader{ nova::data_view(data) };
+    EXPECT_THROWN_MESSAGE(reader.seek(9), "Out of bounds access");
+    EXPECT_ASSERTION_FAIL(std::ignore = reader.read<std::uint8_t>(9));
+}
+
+TEST(BitWriter, MsbFirst) {
+    auto writer = nova::bit_writer{ };
+    writer.write(1, 1);
+    writer.write(2, 2);
+    writer.write(0b0'0001'1010, 9);
+    writer.write(0b0011, 4);
+    EXPECT_EQ(writer.pos(), 16);
+    EXPECT_EQ(nova::data_view(writer.data()).as_hex_string(), "c1a3");
+}
+
+TEST(BitWriter, LsbFirst) {
+    auto writer = nova::bit_writer<nova::bit_order::lsb_first>{ };
+    writer.write(1, 1);
+    writer.write(0, 2);
+    writer.write(0b0'0111'1000, 9);
+    writer.write(0b1010, 4);
+    EXPECT_EQ(nova::data_view(writer.data()).as_hex_string(), "c1a3");
+}
+
+TEST(BitWriter, AlignAndPad) {
+    auto writer = nova::bit_writer{ };
+    writer.write(1, 1);
+    writer.align();
+    EXPECT_EQ(writer.pos(), 8);
+    writer.pad(1_byte);
+    writer.write(0xFF, 8_bit);
+    writer.write(1, 1);
+    EXPECT_EQ(nova::data_view(writer.data()).as_hex_string(), "8000ff80");
+}
+
+TEST(BitWriter, Reset) {
+    auto writer = nova::bit_writer{ };
+    writer.write(0xABCD, 16);
+    writer.write(1, 1);
+    writer.reset();
+    EXPECT_EQ(writer.pos(), 0);
+
+    writer.write(0b101, 3);
+    EXPECT_EQ(nova::data_view(writer.data()).as_hex_string(), "a0");
+}
+
+TEST(BitWriter, IntoSerializerContext) {
+    auto ser = nova::serializer_context{ };
+    ser(std::uint8_t{ 0xAB });
+
+    auto writer = nova::bit_writer{ ser };
+    writer.write(0b101, 3);
+    writer.write(0x1FFF, 13);
+    writer.write(1, 1);
+    writer.finish();
+
+    ser(std::uint16_t{ 0xCDEF });
+    EXPECT_EQ(nova::data_view(ser.data()).as_hex_string(), "ab" "bfff" "80" "cdef");
+}
+
+template <nova::bit_order Order>
+void round_trip() {
+    auto writer = nova::bit_writer<Order>{ };
+    auto fields = std::vector<std::pair<std::uint64_t, std::size_t>>{ };
+
+    for (std::size_t i = 0; i < 200; ++i) {
+        const auto length = (i * 7) % 64 + 1;
+        const auto value = (0x9E37'79B9'7F4A'7C15ULL * (i + 1)) >> (64 - length);
+        fields.emplace_back(value, length);
+        writer.write(value, length);
+    }
+
+    const auto data = writer.data();
+    auto reader = nova::bit_reader<Order>{ nova::data_view(data) };
+    for (const auto& [value, length] : fields) {
+        EXPECT_EQ(reader.read(length), value) << "Length=" << length;
+    }
+    EXPECT_LT(reader.remaining(), 8);
+}
+
+TEST(BitWriter, RoundTrip_MsbFirst) {
+    round_trip<nova::bit_order::msb_first>();
+}
+
+TEST(BitWriter, RoundTrip_LsbFirst) {
+    round_trip<nova::bit_order::lsb_first>();
+}
+
+TEST(BitWriter, ValueDoesNotFit) {
+    auto writer = nova::bit_writer{ };
+    EXPECT_ASSERTION_FAIL(writer.write(4, 2));
+}
@@ -0,0 +1,137 @@
+/**
+ * Part of Nova C++ Library.
+ *
+ * Checksums over binary data.
+ *
+ * CRC32C (Castagnoli) is computed with the SSE4.2 `crc32` instruction if the
+ * CPU supports it (detected at runtime), otherwise with slicing-by-8 tables.
+ *
+ * The checksum can be updated incrementally by passing the previous result,
+ * so data can be verified chunk by chunk while it flows through a buffer:
+ *
+ * ```cpp
+ * auto crc = nova::crc32c(header);
+ * crc = nova::crc32c(payload, crc);        // Same as `crc32c(header + payload)`
+ * ```
+ */
+
+#pragma once
+
+#include <libnova/data.hpp>
+#include <libnova/intrinsics.hpp>
+#include <libnova/std_extensions.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace nova {
+
+namespace detail {
+
+    /**
+     * @brief   Slicing-by-8 tables of the reflected CRC32C polynomial.
+     *
+     * Table `k` is the CRC of a byte followed by `k` zero bytes.
+     */
+    inline constexpr auto Crc32cTables = []() {
+        constexpr auto Polynomial = std::uint32_t{ 0x82F6'3B78 };
+        auto ret = std::array<std::array<std::uint32_t, 256>, 8>{ };
+
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            auto crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc >> 1U) ^ ((crc & 1U) != 0 ? Polynomial : 0);
+            }
+            ret[0][i] = crc;
+        }
+        for (std::size_t k = 1; k < ret.size(); ++k) {
+            for (std::size_t i = 0; i < 256; ++i) {
+                ret[k][i] = (ret[k - 1][i] >> 8U) ^ ret[0][ret[k - 1][i] & 0xFFU];
+            }
+        }
+        return ret;
+    }();
+
+    /**
+     * @brief   Update a (non-inverted) CRC32C state with slicing-by-8.
+     */
+    [[nodiscard]] inline auto crc32c_portable(std::uint32_t crc, const std::byte* src, std::size_t count) -> std::uint32_t {
+        const auto& t = Crc32cTables;
+        std::size_t i = 0;
+
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        for (; i + 8 <= count; i += 8) {
+            auto words = std::array<std::uint32_t, 2>{ };
+            load_numbers<endian::little>(words.data(), src + i, words.size());
+            const auto lo = words[0] ^ crc;
+            const auto hi = words[1];
+            crc = t[7][lo & 0xFFU] ^ t[6][(lo >> 8U) & 0xFFU] ^ t[5][(lo >> 16U) & 0xFFU] ^ t[4][lo >> 24U]
+                ^ t[3][hi & 0xFFU] ^ t[2][(hi >> 8U) & 0xFFU] ^ t[1][(hi >> 16U) & 0xFFU] ^ t[0][hi >> 24U];
+        }
+        for (; i < count; ++i) {
+            crc = (crc >> 8U) ^ t[0][(crc ^ std::to_integer<std::uint32_t>(src[i])) & 0xFFU];
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        return crc;
+    }
+
+#if defined(__x86_64__) and (defined(NOVA_GCC) or defined(NOVA_CLANG))
+    #define NOVA_CRC32C_SSE42
+
+    /**
+     * @brief   Update a (non-inverted) CRC32C state with the SSE4.2 `crc32`
+     *          instruction, 8 bytes at a time.
+     *
+     * NOTE: the CPU must support SSE4.2, see `has_sse42()`.
+     */
+    [[nodiscard]] __attribute__((target("sse4.2")))
+    inline auto crc32c_sse42(std::uint32_t crc, const std::byte* src, std::size_t count) -> std::uint32_t {
+        auto crc64 = std::uint64_t{ crc };
+        std::size_t i = 0;
+
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        for (; i + 8 <= count; i += 8) {
+            auto word = std::uint64_t{ };
+            std::memcpy(&word, src + i, sizeof(word));
+            crc64 = _mm_crc32_u64(crc64, word);
+        }
+        crc = static_cast<std::uint32_t>(crc64);
+        for (; i < count; ++i) {
+            crc = _mm_crc32_u8(crc, std::to_integer<std::uint8_t>(src[i]));
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        return crc;
+    }
+
+    [[nodiscard]] inline auto has_sse42() -> bool {
+        static const bool ret = __builtin_cpu_supports("sse4.2");
+        return ret;
+    }
+#endif
+
+} // namespace detail
+
+/**
+ * @brief   CRC32C (Castagnoli) checksum of the data.
+ *
+ * @param crc   The checksum of the preceding data, for incremental updates.
+ */
+template <endian E, bool B>
+[[nodiscard]] auto crc32c(const detail::data_view<E, B>& data, std::uint32_t crc = 0) -> std::uint32_t {
+#ifdef NOVA_CRC32C_SSE42
+    #if defined(__SSE4_2__)
+    return ~detail::crc32c_sse42(~crc, data.ptr(), data.size());
+    #else
+    if (detail::has_sse42()) {
+        return ~detail::crc32c_sse42(~crc, data.ptr(), data.size());
+    }
+    #endif
+#endif
+    return ~detail::crc32c_portable(~crc, data.ptr(), data.size());
+}
+
+} // namespace nova
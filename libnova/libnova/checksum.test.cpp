@@ -0,0 +1,65 @@
+#include <libnova/checksum.hpp>
+#include <libnova/data.hpp>
+#include <libnova/test_utils.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+using namespace nova::literals;
+
+// Test vectors from RFC 3720 (iSCSI), Appendix B.4
+TEST(Crc32c, KnownValues) {
+    auto data = std::array<std::uint8_t, 32>{ };
+    EXPECT_EQ(nova::crc32c(nova::data_view(data)), 0x8A91'36AA);
+
+    data.fill(0xFF);
+    EXPECT_EQ(nova::crc32c(nova::data_view(data)), 0x62A8'AB43);
+
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<std::uint8_t>(i);
+    }
+    EXPECT_EQ(nova::crc32c(nova::data_view(data)), 0x46DD'794E);
+
+    EXPECT_EQ(nova::crc32c("123456789"_data), 0xE306'9283);
+    EXPECT_EQ(nova::crc32c(""_data), 0);
+}
+
+TEST(Crc32c, Incremental) {
+    const auto data = sample_data(1000);
+    const auto view = nova::data_view(data);
+    const auto expected = nova::crc32c(view);
+
+    for (const auto split : std::to_array<std::size_t>({ 0, 1, 7, 8, 9, 500, 999, 1000 })) {
+        const auto crc = nova::crc32c(view.subview(0, split));
+        EXPECT_EQ(nova::crc32c(view.subview(split), crc), expected) << "Split=" << split;
+    }
+
+    auto crc = std::uint32_t{ };
+    for (std::size_t pos = 0; pos < data.size(); pos += 13) {
+        crc = nova::crc32c(view.subview(pos, std::min<std::size_t>(13, data.size() - pos)), crc);
+    }
+    EXPECT_EQ(crc, expected);
+}
+
+TEST(Crc32c, PortableSameAsSse42) {
+#ifdef NOVA_CRC32C_SSE42
+    if (not nova::detail::has_sse42()) {
+        GTEST_SKIP() << "SSE4.2 is not supported";
+    }
+
+    const auto data = sample_data(300);
+    const auto* ptr = nova::data_view(data).ptr();
+    for (std::size_t size = 0; size <= data.size(); size += 7) {
+        EXPECT_EQ(
+            nova::detail::crc32c_portable(0xFFFF'FFFF, ptr, size),
+            nova::detail::crc32c_sse42(0xFFFF'FFFF, ptr, size)
+        ) << "Size=" << size;
+    }
+#else
+    GTEST_SKIP() << "SSE4.2 is not available on this platform";
+#endif
+}
@@ -3,14 +3,31 @@
  *
  * Handling binary data; serialization and deserialization.
  *
- * - Deserialization: `data_view` for safely interpreting binary data.
+ * - Deserialization:
+ *   - `data_view` for safely interpreting binary data.
+ *   - `deserializer_context` class for reading sequentially
+ *   - `deserialize<T>(view)` free function for convenience
  * - Serialization:
  *   - `serializer_context` class for low-level handling
  *   - `serialize(x)` free function for convenience
  * - Stream buffer
+ * - Hex encoding with `data_view::as_hex_string()` and decoding with `from_hex()`
+ * - Searching with `data_view::find()` and `data_view::find_first_of()`
  *
- * A `serializer<T>` specialization is required for type `T` to be able to
- * serialize it.
+ * Integers are fixed width by default; wrap them in `varint` for a variable
+ * length (LEB128) encoding. `float` and `double` are written bit-exact as
+ * IEEE 754 binary32 and binary64 numbers, in the byte order of the context.
+ *
+ * Aggregates are (de)serialized member by member automatically. For other
+ * types, a `serializer<T>` specialization is required for type `T` to be able
+ * to serialize it, and a `deserializer<T>` one to deserialize it.
+ *
+ * Standard containers are supported out of the box: `std::vector` (with a
+ * varint length prefix), `std::array`, `std::optional`, `std::variant`,
+ * `std::tuple`, `std::pair` and `flat_map`. Strings and spans of numbers are
+ * written as they are on their own, but with a varint length prefix inside
+ * these containers and as members of aggregates, so that they can be read
+ * back.
  *
  * ```cpp
  * struct data {
@@ -24,11 +41,27 @@
  *     }
  * };
  * ```
+ *
+ * The serializer context is big endian by default. To support every byte
+ * order, take the context as a template:
+ *
+ * ```cpp
+ * template <endian Endianness, typename Allocator>
+ * void operator()(detail::serializer_context<Endianness, Allocator>& ser, const data& x);
+ * ```
+ *
+ * A context can be reused with `reset()` to avoid allocating a new buffer for
+ * every message, and it can sit on an arena with a custom allocator (e.g.,
+ * `nova::pmr::serializer_context`).
  */
 
 #pragma once
 
 #include <libnova/error.hpp>
+#include <libnova/expected.hpp>
+#include <libnova/flat_map.hpp>
+#include <libnova/intrinsics.hpp>
+#include <libnova/std_extensions.hpp>
 #include <libnova/type_traits.hpp>
 #include <libnova/types.hpp>
 #include <libnova/units.hpp>
@@ -37,19 +70,35 @@
 #include <fmt/core.h>
 #include <fmt/format.h>
 
+#ifdef NOVA_LINUX
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <cerrno>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <ranges>
 #include <span>
 #include <streambuf>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+#include <variant>
 #include <vector>
 
 namespace std {
@@ -89,6 +138,11 @@ struct char_traits<std::byte> {
             return 0;
         }
 
+        if (not is_constant_evaluated()) {
+            const auto ret = memcmp(lhs, rhs, n);
+            return (ret > 0) - (ret < 0);
+        }
+
         for (size_t i = 0; i < n; ++i) {
             if (lt(lhs[i], rhs[i])) {                                                               // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
                 return -1;
@@ -104,6 +158,10 @@ struct char_traits<std::byte> {
     static constexpr auto length(const char_type* ch) -> size_t NOVA_DELETE("Cannot tell the length of a byte array given only a pointer");
 
     static constexpr auto find(const char_type* where, size_t n, const char_type& what) -> const char_type* {
+        if (not is_constant_evaluated()) {
+            return n == 0 ? nullptr : static_cast<const char_type*>(memchr(where, to_integer<int>(what), n));
+        }
+
         for (size_t i = 0; i < n; ++i) {
             if (*where == what) {
                 return where;
@@ -193,13 +251,548 @@ concept binary_interpretable =
     || std::is_same_v<T, std::uint8_t>
     || std::is_same_v<T, std::byte>;
 
+/**
+ * @brief   Byte order of binary data.
+ *
+ * `native` is the byte order of the host, i.e., it is equal to either `big`
+ * or `little` (similarly to `std::endian`).
+ */
 enum class endian : std::uint8_t {
     big,
     little,
+    native = std::endian::native == std::endian::big ? big : little,
+};
+
+/**
+ * @brief   Integer (de)serialized as a variable-length integer (LEB128).
+ *
+ * 7 bits are stored per byte starting with the least significant group; the
+ * highest bit of a byte tells whether more bytes follow. Signed integers are
+ * zigzag encoded, so values of small magnitude take few bytes either way.
+ *
+ * ```cpp
+ * ser(nova::varint{ length });
+ *
+ * auto length = nova::varint<std::uint32_t>{ };
+ * deser(length);
+ * ```
+ */
+template <std::integral T>
+struct varint {
+    T value{ };
+
+    constexpr varint() = default;
+
+    [[nodiscard]] constexpr explicit varint(T x)
+        : value(x)
+    {}
 };
 
+/**
+ * @brief   Tag for `data_view::as_dyn_string` to read a varint length prefix.
+ */
+struct varint_length_t { };
+
+inline constexpr auto varint_length = varint_length_t{ };
+
+/**
+ * @brief   IEEE 754 binary32 and binary64 types, (de)serialized bit-exact.
+ */
+template <typename T>
+concept ieee_floating_point =
+    std::floating_point<T>
+    and std::numeric_limits<T>::is_iec559
+    and (sizeof(T) == sizeof(std::uint32_t) or sizeof(T) == sizeof(std::uint64_t));
+
+/**
+ * @brief   Numbers serialized in their fixed width: unsigned integers and IEEE
+ *          floating point numbers.
+ */
+template <typename T>
+concept fixed_width_number = std::unsigned_integral<T> or ieee_floating_point<T>;
+
 namespace detail {
 
+/**
+ * @brief   Unsigned integer of the same size as a floating point type, for
+ *          swapping its bytes; integers are left as they are.
+ */
+template <typename T>
+using byteswap_type_t = std::conditional_t<
+    std::floating_point<T>,
+    std::conditional_t<sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>,
+    T
+>;
+
+/**
+ * @brief   Shuffle mask for reversing the bytes of each `T` in a 16 byte vector.
+ */
+template <typename T>
+inline constexpr auto byteswap_shuffle_mask = []() {
+    auto ret = std::array<std::int8_t, 16>{ };
+    for (std::size_t i = 0; i < ret.size(); ++i) {
+        const auto first = i - i % sizeof(T);
+        ret[i] = static_cast<std::int8_t>(first + sizeof(T) - 1 - i % sizeof(T));
+    }
+    return ret;
+}();
+
+/**
+ * @brief   Copy `count` integers while reversing the bytes of each.
+ *
+ * Blocks of 32 or 16 bytes are swapped at once with byte shuffles if AVX2 or
+ * SSSE3 is enabled at compile-time (e.g. `-mavx2`); the rest is swapped one
+ * by one.
+ */
+template <std::integral T>
+void byteswap_copy(std::byte* dest, const std::byte* src, std::size_t count) {
+    std::size_t i = 0;
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+    // NOLINTBEGIN(*reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic) | Unaligned SIMD loads and stores
+    const auto mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(byteswap_shuffle_mask<T>.data()));
+
+    #if defined(__AVX2__)
+    static constexpr auto Lanes256 = 32 / sizeof(T);
+    const auto mask256 = _mm256_broadcastsi128_si256(mask);
+
+    for (; i + Lanes256 <= count; i += Lanes256) {
+        const auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * sizeof(T)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i * sizeof(T)), _mm256_shuffle_epi8(x, mask256));
+    }
+    #endif
+
+    static constexpr auto Lanes128 = 16 / sizeof(T);
+
+    for (; i + Lanes128 <= count; i += Lanes128) {
+        const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * sizeof(T)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i * sizeof(T)), _mm_shuffle_epi8(x, mask));
+    }
+    // NOLINTEND(*reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+#endif
+
+    for (; i < count; ++i) {
+        auto x = T{ };
+        std::memcpy(&x, src + i * sizeof(T), sizeof(T));                                            // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        x = nova::byteswap(x);
+        std::memcpy(dest + i * sizeof(T), &x, sizeof(T));                                           // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+}
+
+/**
+ * @brief   Copy `count` integers or floating point numbers into a byte array
+ *          in the given byte order.
+ *
+ * It is a plain `memcpy` if the byte order matches the host's, otherwise
+ * every element is byte-swapped.
+ */
+template <endian Endianness, typename T>
+    requires std::integral<T> or ieee_floating_point<T>
+void store_numbers(std::byte* dest, const T* src, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    if constexpr (Endianness == endian::native or sizeof(T) == 1) {
+        std::memcpy(dest, src, count * sizeof(T));
+    }
+    else {
+        byteswap_copy<byteswap_type_t<T>>(dest, reinterpret_cast<const std::byte*>(src), count);   // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast) | Numbers are accessed as bytes
+    }
+}
+
+/**
+ * @brief   Read `count` integers or floating point numbers in the given byte
+ *          order from a byte array.
+ *
+ * Counterpart of `store_numbers()`.
+ */
+template <endian Endianness, typename T>
+    requires std::integral<T> or ieee_floating_point<T>
+void load_numbers(T* dest, const std::byte* src, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    if constexpr (Endianness == endian::native or sizeof(T) == 1) {
+        std::memcpy(dest, src, count * sizeof(T));
+    }
+    else {
+        byteswap_copy<byteswap_type_t<T>>(reinterpret_cast<std::byte*>(dest), src, count);         // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast) | Numbers are accessed as bytes
+    }
+}
+
+/**
+ * @brief   Maximum number of bytes of a varint encoded `T`.
+ */
+template <std::integral T>
+inline constexpr std::size_t MaxVarintSize = (sizeof(T) * 8 + 6) / 7;
+
+/**
+ * @brief   Map signed integers to unsigned ones by interleaving positive and
+ *          negative values: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+ *
+ * Unsigned integers are returned as they are.
+ */
+template <std::integral T>
+[[nodiscard]] constexpr auto zigzag_encode(T x) -> std::make_unsigned_t<T> {
+    using U = std::make_unsigned_t<T>;
+
+    if constexpr (std::is_signed_v<T>) {
+        return static_cast<U>(static_cast<U>(static_cast<U>(x) << 1U) ^ static_cast<U>(x >> (sizeof(T) * 8 - 1)));
+    }
+    else {
+        return x;
+    }
+}
+
+/**
+ * @brief   Inverse of `zigzag_encode()`.
+ */
+template <std::integral T>
+[[nodiscard]] constexpr auto zigzag_decode(std::make_unsigned_t<T> x) -> T {
+    using U = std::make_unsigned_t<T>;
+
+    if constexpr (std::is_signed_v<T>) {
+        return static_cast<T>(static_cast<U>(static_cast<U>(x >> 1U) ^ static_cast<U>(U{ 0 } - (x & 1U))));
+    }
+    else {
+        return x;
+    }
+}
+
+/**
+ * @brief   Write `x` as a varint.
+ *
+ * `dest` must have room for `MaxVarintSize<T>` bytes.
+ *
+ * @returns the number of bytes written.
+ */
+template <std::unsigned_integral T>
+auto store_varint(std::byte* dest, T x) -> std::size_t {
+    std::size_t i = 0;
+    for (; x >= 0x80; ++i) {
+        dest[i] = static_cast<std::byte>(x | 0x80U);                                                // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        x = static_cast<T>(x >> 7U);
+    }
+    dest[i] = static_cast<std::byte>(x);                                                            // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return i + 1;
+}
+
+/**
+ * @brief   Gather the 7-bit groups of a little endian word of varint bytes.
+ */
+[[nodiscard]] inline auto compact_varint_word(std::uint64_t word) -> std::uint64_t {
+#if defined(__BMI2__)
+    return _pext_u64(word, 0x7F7F'7F7F'7F7F'7F7FULL);
+#else
+    word = (word & 0x007F'007F'007F'007FULL) | ((word & 0x7F00'7F00'7F00'7F00ULL) >> 1U);
+    word = (word & 0x0000'3FFF'0000'3FFFULL) | ((word & 0x3FFF'0000'3FFF'0000ULL) >> 2U);
+    return (word & 0x0000'0000'0FFF'FFFFULL) | ((word & 0x0FFF'FFFF'0000'0000ULL) >> 4U);
+#endif
+}
+
+/**
+ * @brief   A decoded varint and its size in bytes.
+ *
+ * The size is zero if the varint is truncated, or it is too long for `T`.
+ */
+template <typename T>
+struct decoded_varint {
+    T value;
+    std::size_t size;
+};
+
+/**
+ * @brief   Read a varint from at most `available` bytes.
+ *
+ * Single byte values return right away. Otherwise, if there are at least 8
+ * bytes, a whole word is loaded and the terminating byte is found with a bit
+ * scan, so values up to 56 bits are decoded without a loop. Longer values and
+ * values at the end of the data are decoded byte by byte.
+ */
+template <std::unsigned_integral T>
+[[nodiscard]] auto load_varint(const std::byte* src, std::size_t available) -> decoded_varint<T> {
+    static constexpr auto Invalid = decoded_varint<T>{ 0, 0 };
+
+    const auto fits = [](std::uint64_t value) {
+        return sizeof(T) == sizeof(std::uint64_t) or value <= std::numeric_limits<T>::max();
+    };
+
+    if (available == 0) {
+        return Invalid;
+    }
+
+    const auto first = std::to_integer<std::uint8_t>(*src);
+    if (first < 0x80) {
+        return { static_cast<T>(first), 1 };
+    }
+
+    if (available >= sizeof(std::uint64_t)) {
+        auto word = std::uint64_t{ };
+        std::memcpy(&word, src, sizeof(word));
+        if constexpr (endian::native == endian::big) {
+            word = nova::byteswap(word);
+        }
+
+        const auto stops = ~word & 0x8080'8080'8080'8080ULL;
+        if (stops != 0) {
+            const auto size = static_cast<std::size_t>(std::countr_zero(stops)) / 8 + 1;
+            // Keep the bytes up to the terminating one (wraps to all ones for the 8th byte).
+            const auto value = compact_varint_word(word & (((stops & (~stops + 1)) << 1U) - 1));
+            if (size > MaxVarintSize<T> or not fits(value)) {
+                return Invalid;
+            }
+            return { static_cast<T>(value), size };
+        }
+    }
+
+    // The 10th byte holds only the top bit of a 64-bit value
+    static constexpr auto LastByte = MaxVarintSize<std::uint64_t> - 1;
+
+    auto value = std::uint64_t{ };
+    for (std::size_t i = 0; i < std::min(available, MaxVarintSize<T>); ++i) {
+        const auto byte = std::to_integer<std::uint64_t>(src[i]);                                  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (i == LastByte and byte > 1) {
+            return Invalid;
+        }
+        value |= (byte & 0x7FU) << (7 * i);
+        if (byte < 0x80) {
+            return fits(value) ? decoded_varint<T>{ static_cast<T>(value), i + 1 } : Invalid;
+        }
+    }
+    return Invalid;
+}
+
+/**
+ * @brief   Lowercase hex digit pairs of every byte value.
+ */
+inline constexpr auto HexPairs = []() {
+    constexpr auto digits = std::string_view{ "0123456789abcdef" };
+    auto ret = std::array<char, 512>{ };
+    for (std::size_t i = 0; i < 256; ++i) {
+        ret[2 * i] = digits[i >> 4U];
+        ret[2 * i + 1] = digits[i & 0xFU];
+    }
+    return ret;
+}();
+
+/**
+ * @brief   Value of every hex digit (either case), `0xFF` for other characters.
+ */
+inline constexpr auto HexValues = []() {
+    auto ret = std::array<std::uint8_t, 256>{ };
+    ret.fill(0xFF);
+    for (std::uint8_t i = 0; i < 10; ++i) {
+        ret[static_cast<std::size_t>('0' + i)] = i;
+    }
+    for (std::uint8_t i = 0; i < 6; ++i) {
+        ret[static_cast<std::size_t>('a' + i)] = static_cast<std::uint8_t>(10 + i);
+        ret[static_cast<std::size_t>('A' + i)] = static_cast<std::uint8_t>(10 + i);
+    }
+    return ret;
+}();
+
+/**
+ * @brief   Write `count` bytes as `2 * count` lowercase hex digits.
+ *
+ * 16 bytes are encoded at once with byte shuffles if SSSE3 is enabled at
+ * compile-time; the rest is looked up in a table.
+ */
+inline void hex_encode(char* dest, const std::byte* src, std::size_t count) {
+    std::size_t i = 0;
+
+    // NOLINTBEGIN(*reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic) | Low-level code
+#if defined(__SSSE3__)
+    const auto digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const auto low_nibbles = _mm_set1_epi8(0x0F);
+
+    for (; i + 16 <= count; i += 16) {
+        const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const auto hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(x, 4), low_nibbles));
+        const auto lo = _mm_shuffle_epi8(digits, _mm_and_si128(x, low_nibbles));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        std::memcpy(dest + 2 * i, &HexPairs[2 * std::to_integer<std::size_t>(src[i])], 2);
+    }
+    // NOLINTEND(*reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
+/**
+ * @brief   Read `count` bytes from `2 * count` hex digits (either case).
+ *
+ * 16 digits are validated and decoded at once if SSSE3 is enabled at
+ * compile-time; the rest is looked up in a table.
+ *
+ * @returns the position of the first invalid digit, or `std::string_view::npos`.
+ */
+inline auto hex_decode(std::byte* dest, const char* src, std::size_t count) -> std::size_t {
+    std::size_t i = 0;
+
+    // NOLINTBEGIN(*reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic) | Low-level code
+#if defined(__SSSE3__)
+    const auto weights = _mm_set1_epi16(0x0110);        // 16 for the high, 1 for the low digit
+
+    for (; i + 8 <= count; i += 8) {
+        const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i));
+        const auto lower = _mm_or_si128(x, _mm_set1_epi8(0x20));
+
+        const auto is_digit = _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(x, _mm_set1_epi8('9' + 1)));
+        const auto is_alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+        if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) != 0xFFFF) {
+            break;
+        }
+
+        const auto values = _mm_or_si128(
+            _mm_and_si128(is_digit, _mm_sub_epi8(x, _mm_set1_epi8('0'))),
+            _mm_and_si128(is_alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)))
+        );
+        const auto bytes = _mm_maddubs_epi16(values, weights);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dest + i), _mm_packus_epi16(bytes, bytes));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const auto hi = HexValues[static_cast<unsigned char>(src[2 * i])];
+        const auto lo = HexValues[static_cast<unsigned char>(src[2 * i + 1])];
+        if (hi == 0xFF or lo == 0xFF) {
+            return hi == 0xFF ? 2 * i : 2 * i + 1;
+        }
+        dest[i] = static_cast<std::byte>(hi << 4U | lo);
+    }
+    // NOLINTEND(*reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    return std::string_view::npos;
+}
+
+/**
+ * @brief   Check whether all bytes are ASCII printable, 16 at a time with SSE2.
+ */
+[[nodiscard]] inline auto all_printable(const std::byte* src, std::size_t count) -> bool {
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    const auto low = _mm_set1_epi8(static_cast<char>(ascii::PrintableRange.low - 1));
+    const auto high = _mm_set1_epi8(static_cast<char>(ascii::PrintableRange.high + 1));
+
+    for (; i + 16 <= count; i += 16) {
+        const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));               // NOLINT(*reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic) | Unaligned SIMD load
+        // Bytes above 127 are negative as signed, so they fail the first comparison.
+        if (_mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(x, low), _mm_cmplt_epi8(x, high))) != 0xFFFF) {
+            return false;
+        }
+    }
+#endif
+
+    return std::all_of(src + i, src + count, [](auto b) { return is_printable(b); });             // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
+/**
+ * @brief   Position of the first occurrence of `needle` in `src`, or
+ *          `std::string_view::npos`.
+ *
+ * With SSE2, positions where both the first and the last byte of the needle
+ * match are found 16 at a time, and only those are compared in full. Single
+ * bytes are searched with `memchr`.
+ */
+[[nodiscard]] inline auto find_bytes(const std::byte* src, std::size_t count, const std::byte* needle, std::size_t length) -> std::size_t {
+    if (length == 0) {
+        return 0;
+    }
+    if (length > count) {
+        return std::string_view::npos;
+    }
+    if (length == 1) {
+        const auto* ptr = static_cast<const std::byte*>(std::memchr(src, std::to_integer<int>(*needle), count));
+        return ptr == nullptr ? std::string_view::npos : static_cast<std::size_t>(std::distance(src, ptr));
+    }
+
+    // NOLINTBEGIN(*reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic) | Unaligned SIMD loads
+    const auto rest_matches = [&](std::size_t i) {
+        return std::memcmp(src + i + 1, needle + 1, length - 2) == 0;
+    };
+
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    const auto first = _mm_set1_epi8(std::to_integer<char>(needle[0]));
+    const auto last = _mm_set1_epi8(std::to_integer<char>(needle[length - 1]));
+
+    for (; i + length - 1 + 16 <= count; i += 16) {
+        const auto block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const auto block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + length - 1));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last))
+        ));
+        for (; mask != 0; mask &= mask - 1) {
+            const auto candidate = i + static_cast<std::size_t>(std::countr_zero(mask));
+            if (rest_matches(candidate)) {
+                return candidate;
+            }
+        }
+    }
+#endif
+
+    for (; i + length <= count; ++i) {
+        if (src[i] == needle[0] and src[i + length - 1] == needle[length - 1] and rest_matches(i)) {
+            return i;
+        }
+    }
+    // NOLINTEND(*reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    return std::string_view::npos;
+}
+
+/**
+ * @brief   Position of the first byte in `src` that is in `set`, or
+ *          `std::string_view::npos`.
+ *
+ * With SSE2, sets of up to 8 bytes are matched 16 bytes at a time; larger
+ * sets are looked up in a table byte by byte.
+ */
+[[nodiscard]] inline auto find_any_of(const std::byte* src, std::size_t count, const std::byte* set, std::size_t set_size) -> std::size_t {
+    static constexpr std::size_t MaxSimdSet = 8;
+    std::size_t i = 0;
+
+    // NOLINTBEGIN(*reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic) | Unaligned SIMD loads
+#if defined(__SSE2__)
+    if (set_size <= MaxSimdSet) {
+        auto members = std::array<char, MaxSimdSet>{ };
+        for (std::size_t j = 0; j < set_size; ++j) {
+            members[j] = std::to_integer<char>(set[j]);
+        }
+
+        for (; i + 16 <= count; i += 16) {
+            const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            auto matches = _mm_setzero_si128();
+            for (std::size_t j = 0; j < set_size; ++j) {
+                matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, _mm_set1_epi8(members[j])));
+            }
+            if (const auto mask = static_cast<unsigned>(_mm_movemask_epi8(matches)); mask != 0) {
+                return i + static_cast<std::size_t>(std::countr_zero(mask));
+            }
+        }
+    }
+#endif
+
+    auto table = std::array<bool, 256>{ };
+    for (std::size_t j = 0; j < set_size; ++j) {
+        table[std::to_integer<std::size_t>(set[j])] = true;
+    }
+    for (; i < count; ++i) {
+        if (table[std::to_integer<std::size_t>(src[i])]) {
+            return i;
+        }
+    }
+    // NOLINTEND(*reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    return std::string_view::npos;
+}
+
 /**
  * @brief   A binary data view on a range.
  *
@@ -209,7 +802,8 @@ namespace detail {
  * the `data_view` does not outlive the data it refers to.
  *
  * @throws  All accessor member functions throw if `RuntimeBoundCheck`
- *          is turned on, else calls to `assert` (debug mode check)
+ *          is turned on, else calls to `assert` (debug mode check); see
+ *          `checked()` for checking a region once.
  */
 template <endian Endianness = endian::big, bool RuntimeBoundCheck = true>
 class data_view {
@@ -219,6 +813,7 @@ class data_view {
     using Measure = units::measure<units::data_volume, long long, R>;
 
 public:
+    static constexpr auto npos = std::string_view::npos;
 
     template <typename Range>
         requires binary_interpretable<std::remove_cv_t<typename Range::value_type>>
@@ -244,6 +839,22 @@ public:
         return data_view(m_data.subspan(offset, length));
     }
 
+    /**
+     * @brief   Check the bounds of a region once, to decode it without further
+     *          runtime checks.
+     *
+     * ```cpp
+     * const auto record = view.checked(pos, 16);      // Throws if out of bounds
+     * record.as_number<std::uint32_t>(4);             // Only asserts
+     * ```
+     *
+     * @returns a view of `length` bytes from `pos` whose accessors only assert.
+     */
+    [[nodiscard]] auto checked(std::size_t pos, std::size_t length) const -> data_view<Endianness, false> {
+        boundary_check(pos, length);
+        return { std::next(m_data.data(), static_cast<std::ptrdiff_t>(pos)), length };
+    }
+
     [[nodiscard]] auto begin() const { return std::begin(m_data); }
     [[nodiscard]] auto begin()       { return std::begin(m_data); }
     [[nodiscard]] auto end()   const { return std::end(m_data); }
@@ -340,46 +951,150 @@ public:
     /**
      * @brief   Interpret data as number according to the type `T`.
      *
-     * This is wrapper around `as_number(pos, len)`.
+     * Same as `as_number(pos, sizeof(T))`, but it is a single load (and a byte
+     * swap if the byte order differs from the host's).
+     *
+     * `float` and `double` are read bit-exact as IEEE 754 numbers.
      */
     template <typename T>
-        requires std::is_integral_v<T>
+        requires std::is_integral_v<T> or ieee_floating_point<T>
     [[nodiscard]] auto as_number(std::size_t pos) const -> T {
-        return as_number<T>(pos, sizeof(T));
+        if constexpr (std::floating_point<T>) {
+            return std::bit_cast<T>(as_number<byteswap_type_t<T>>(pos));
+        }
+        else {
+            boundary_check(pos, sizeof(T));
+
+            auto ret = T{ };
+            std::memcpy(&ret, std::next(m_data.data(), static_cast<std::ptrdiff_t>(pos)), sizeof(T));
+
+            if constexpr (Endianness != endian::native) {
+                ret = nova::byteswap(ret);
+            }
+            return ret;
+        }
     }
 
     /**
-     * @brief   Interpret data as number according to the type `T`.
+     * @brief   Interpret consecutive numbers from `pos` to fill `out`.
+     *
+     * The bounds are checked once for the whole range. Decoding is vectorized
+     * if SSSE3 or AVX2 is enabled at compile-time. It works for `float` and
+     * `double` as well.
+     *
+     * ```cpp
+     * auto samples = std::vector<std::uint16_t>(count);
+     * view.as_numbers(pos, std::span(samples));
+     * ```
      */
-    template <typename T = std::size_t>
-        requires std::is_integral_v<T>
-    [[nodiscard]] auto as_number(extent<std::size_t> ex) const -> T {
-        return as_number(ex.pos, ex.len);
+    template <typename T, std::size_t Extent>
+        requires std::is_integral_v<T> or ieee_floating_point<T>
+    void as_numbers(std::size_t pos, std::span<T, Extent> out) const {
+        boundary_check(pos, out.size_bytes());
+        const auto* src = std::next(m_data.data(), static_cast<std::ptrdiff_t>(pos));
+        load_numbers<Endianness>(out.data(), src, out.size());
     }
 
     /**
-     * @brief   Interpret bit-packed data as number specified by
-     *          `extent<units::measure<...>>`.
-     *
-     * Position and length in `extent` does not need to have the same ratio.
-     *
-     * @param ex    The extent specifing the position and length. Both must
-     *              be a measure representing bits or bytes as an integral
-     *              type.
-     *
-     * @tparam T    Return type which must be an unsigned integer and
-     *              must be able to represent the requrested length.
-     * @tparam R1   Ratio for position in `extent`.
-     * @tparam R2   Ratio for length in `extent`.
+     * @brief   Interpret data as a varint from `pos`.
      *
-     * @example
+     * Signed integers are zigzag decoded.
      *
      * ```cpp
-     * const auto view = nova::data_view(...);
-     * view.as_number<std::size_t>(nova::extent{ 1_byte, 2_bit });
+     * const auto [value, size] = view.as_varint<std::uint32_t>(pos);
      * ```
      *
-     * Note: Bit-packed deserialization is ONLY supported in big endian mode!
+     * @returns the value and the number of bytes it takes.
+     * @throws  if the varint is truncated, or it is too long for `T`.
+     */
+    template <typename T = std::uint64_t>
+        requires std::is_integral_v<T>
+    [[nodiscard]] auto as_varint(std::size_t pos) const -> decoded_varint<T> {
+        using U = std::make_unsigned_t<T>;
+
+        boundary_check(pos, 1);
+        const auto [value, length] = load_varint<U>(std::next(m_data.data(), static_cast<std::ptrdiff_t>(pos)), size() - pos);
+        varint_check<U>(pos, length);
+        return { zigzag_decode<T>(value), length };
+    }
+
+    /**
+     * @brief   Interpret consecutive varints from `pos` to fill `out`.
+     *
+     * If SSE2 is available, runs of 16 single byte values are detected with
+     * a single test, and then they are copied without looking for the
+     * terminating bytes one by one.
+     *
+     * @returns the number of bytes read.
+     * @throws  if a varint is truncated, or it is too long for `T`.
+     */
+    template <typename T, std::size_t Extent>
+        requires std::is_integral_v<T>
+    auto as_varints(std::size_t pos, std::span<T, Extent> out) const -> std::size_t {
+        using U = std::make_unsigned_t<T>;
+
+        boundary_check(pos, 0);
+        const auto start = pos;
+        std::size_t i = 0;
+
+        while (i < out.size()) {
+#if defined(__SSE2__)
+            static constexpr std::size_t Lanes = 16;
+
+            if (out.size() - i >= Lanes and size() - pos >= Lanes) {
+                const auto* src = std::next(m_data.data(), static_cast<std::ptrdiff_t>(pos));
+                const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));         // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast) | Unaligned SIMD load
+                if (_mm_movemask_epi8(block) == 0) {
+                    for (std::size_t j = 0; j < Lanes; ++j) {
+                        out[i + j] = zigzag_decode<T>(static_cast<U>(std::to_integer<std::uint8_t>(m_data[pos + j])));
+                    }
+                    i += Lanes;
+                    pos += Lanes;
+                    continue;
+                }
+            }
+#endif
+            const auto [value, length] = load_varint<U>(std::next(m_data.data(), static_cast<std::ptrdiff_t>(pos)), size() - pos);
+            varint_check<U>(pos, length);
+            out[i] = zigzag_decode<T>(value);
+            ++i;
+            pos += length;
+        }
+        return pos - start;
+    }
+
+    /**
+     * @brief   Interpret data as number according to the type `T`.
+     */
+    template <typename T = std::size_t>
+        requires std::is_integral_v<T>
+    [[nodiscard]] auto as_number(extent<std::size_t> ex) const -> T {
+        return as_number(ex.pos, ex.len);
+    }
+
+    /**
+     * @brief   Interpret bit-packed data as number specified by
+     *          `extent<units::measure<...>>`.
+     *
+     * Position and length in `extent` does not need to have the same ratio.
+     *
+     * @param ex    The extent specifing the position and length. Both must
+     *              be a measure representing bits or bytes as an integral
+     *              type.
+     *
+     * @tparam T    Return type which must be an unsigned integer and
+     *              must be able to represent the requrested length.
+     * @tparam R1   Ratio for position in `extent`.
+     * @tparam R2   Ratio for length in `extent`.
+     *
+     * @example
+     *
+     * ```cpp
+     * const auto view = nova::data_view(...);
+     * view.as_number<std::size_t>(nova::extent{ 1_byte, 2_bit });
+     * ```
+     *
+     * Note: Bit-packed deserialization is ONLY supported in big endian mode!
      */
     template <typename T = std::size_t, typename R1, typename R2 = R1>
         requires std::is_integral_v<T>
@@ -417,185 +1132,1359 @@ public:
         return as_string(pos + length_bytes, str_length);
     }
 
-    [[nodiscard]]
-    auto as_hex_string(std::size_t pos, std::size_t length) const -> std::string {
-        std::string ret;
-
-        for (const auto& ch : m_data.subspan(pos, length)) {
-            ret += fmt::format("{:02x}", ch);
-        }
+    /**
+     * @brief   Interpret data as dynamic length string with a varint length prefix.
+     *
+     * ```cpp
+     * const auto str = view.as_dyn_string(pos, nova::varint_length);
+     * ```
+     */
+    [[nodiscard]]
+    auto as_dyn_string(std::size_t pos, varint_length_t /* tag */) const -> std::string_view {
+        const auto [str_length, length_bytes] = as_varint<std::size_t>(pos);
+        return as_string(pos + length_bytes, str_length);
+    }
+
+    [[nodiscard]]
+    auto as_hex_string(std::size_t pos, std::size_t length) const -> std::string {
+        boundary_check(pos, length);
+
+        auto ret = std::string(2 * length, '\0');
+        hex_encode(ret.data(), std::next(m_data.data(), static_cast<std::ptrdiff_t>(pos)), length);
+        return ret;
+    }
+
+    [[nodiscard]]
+    auto as_hex_string() const -> std::string {
+        return as_hex_string(0, size());
+    }
+
+    /**
+     * @brief   Write the data as lowercase hex digits into `out`.
+     *
+     * A `char*` output has to have room for `2 * size()` characters; other
+     * output iterators are written through a small buffer.
+     *
+     * ```cpp
+     * view.format_hex(std::back_inserter(log_line));
+     * ```
+     */
+    template <std::output_iterator<char> OutputIt>
+    auto format_hex(OutputIt out) const -> OutputIt {
+        if constexpr (std::is_same_v<OutputIt, char*>) {
+            hex_encode(out, m_data.data(), size());
+            return std::next(out, static_cast<std::ptrdiff_t>(2 * size()));
+        }
+        else {
+            static constexpr std::size_t ChunkSize = 256;
+            auto buffer = std::array<char, 2 * ChunkSize>{ };
+
+            for (std::size_t pos = 0; pos < size(); pos += ChunkSize) {
+                const auto length = std::min(ChunkSize, size() - pos);
+                hex_encode(buffer.data(), std::next(m_data.data(), static_cast<std::ptrdiff_t>(pos)), length);
+                out = std::copy_n(buffer.data(), 2 * length, out);
+            }
+            return out;
+        }
+    }
+
+    /**
+     * @brief   Whether all bytes are ASCII printable characters.
+     */
+    [[nodiscard]]
+    auto is_printable() const -> bool {
+        return all_printable(m_data.data(), size());
+    }
+
+    /**
+     * @brief   Position of the first `x` from `pos`, or `npos`.
+     */
+    [[nodiscard]]
+    auto find(std::byte x, std::size_t pos = 0) const -> std::size_t {
+        return find(data_view{ &x, 1 }, pos);
+    }
+
+    /**
+     * @brief   Position of the first occurrence of `needle` from `pos`, or `npos`.
+     *
+     * ```cpp
+     * const auto sync = view.find("\x47\x1F"_data);
+     * ```
+     */
+    template <endian E, bool B>
+    [[nodiscard]]
+    auto find(const data_view<E, B>& needle, std::size_t pos = 0) const -> std::size_t {
+        if (pos > size()) {
+            return npos;
+        }
+        const auto ret = find_bytes(std::next(m_data.data(), static_cast<std::ptrdiff_t>(pos)), size() - pos, needle.ptr(), needle.size());
+        return ret == npos ? npos : pos + ret;
+    }
+
+    /**
+     * @brief   Position of the first byte from `pos` that is any of the bytes
+     *          in `set`, or `npos`.
+     *
+     * ```cpp
+     * const auto end = view.find_first_of("\r\n"_data);
+     * ```
+     */
+    template <endian E, bool B>
+    [[nodiscard]]
+    auto find_first_of(const data_view<E, B>& set, std::size_t pos = 0) const -> std::size_t {
+        if (pos >= size()) {
+            return npos;
+        }
+        const auto ret = find_any_of(std::next(m_data.data(), static_cast<std::ptrdiff_t>(pos)), size() - pos, set.ptr(), set.size());
+        return ret == npos ? npos : pos + ret;
+    }
+
+    [[nodiscard]]
+    auto to_vec() const -> bytes {
+        auto ret = bytes(size());
+
+        std::ranges::copy(
+            std::begin(m_data),
+            std::end(m_data),
+            std::begin(ret)
+        );
+
+        return ret;
+    }
+
+private:
+    std::span<const std::byte> m_data;
+
+    void boundary_check(std::size_t pos, std::size_t length) const {
+        if constexpr (RuntimeBoundCheck) {
+            if (pos > size() or length > size() - pos) {
+                throw exception(
+                    "Out of bounds access: {}",
+                    detail::data_cursor{ pos, length, size() }
+                );
+            }
+        }
+        else {
+            nova_assert(pos <= size() and length <= size() - pos);
+        }
+    }
+
+    template <typename T>
+    void varint_check(std::size_t pos, std::size_t length) const {
+        if constexpr (RuntimeBoundCheck) {
+            if (length == 0) {
+                throw exception(
+                    "Invalid varint: {}",
+                    detail::data_cursor{ pos, std::min(MaxVarintSize<T>, size() - pos), size() }
+                );
+            }
+        }
+        else {
+            nova_assert(length > 0);
+        }
+    }
+
+    void boundary_check_bit(std::size_t pos, std::size_t length) const {
+        if constexpr (RuntimeBoundCheck) {
+            if (size() * Byte < pos + length) {
+                throw exception(
+                    "Out of bounds access: {} (bits)",
+                    detail::data_cursor{ pos, length, size() * Byte }
+                );
+            }
+        }
+        else {
+            nova_assert(pos + length <= size() * Byte);
+        }
+    }
+};
+
+} // namespace detail
+
+using data_view = detail::data_view<>;
+using data_view_be = detail::data_view<endian::big>;
+using data_view_le = detail::data_view<endian::little>;
+
+namespace literals {
+
+    [[nodiscard]] inline
+    auto operator""_data(const char* str, std::size_t n) noexcept {
+        return data_view{ str, n };
+    }
+
+} // namespace literals
+
+namespace detail {
+
+template <endian Endianness = endian::big, typename Allocator = std::allocator<std::byte>>
+class serializer_context;
+
+} // namespace detail
+
+using serializer_context = detail::serializer_context<>;
+using serializer_context_be = detail::serializer_context<endian::big>;
+using serializer_context_le = detail::serializer_context<endian::little>;
+
+namespace pmr {
+
+    using serializer_context = detail::serializer_context<endian::big, std::pmr::polymorphic_allocator<std::byte>>;
+    using serializer_context_be = detail::serializer_context<endian::big, std::pmr::polymorphic_allocator<std::byte>>;
+    using serializer_context_le = detail::serializer_context<endian::little, std::pmr::polymorphic_allocator<std::byte>>;
+
+} // namespace pmr
+
+/**
+ * @brief   Contiguous range of integers, serialized in bulk.
+ */
+template <typename Range>
+concept contiguous_integral_range =
+    std::ranges::contiguous_range<Range>
+    and std::ranges::sized_range<Range>
+    and std::unsigned_integral<std::ranges::range_value_t<Range>>;
+
+/**
+ * @brief   Contiguous range of integers or floating point numbers, serialized
+ *          in bulk.
+ */
+template <typename Range>
+concept contiguous_number_range =
+    std::ranges::contiguous_range<Range>
+    and std::ranges::sized_range<Range>
+    and fixed_width_number<std::ranges::range_value_t<Range>>;
+
+template <typename T>
+struct serializer;
+
+template <typename T>
+struct deserializer;
+
+namespace detail {
+
+inline constexpr std::size_t MaxAggregateFields = 16;
+
+/**
+ * @brief   Aggregates that can be (de)serialized member by member.
+ *
+ * Arrays and ranges are aggregates too, but they are not enumerated by their
+ * members. C array members are not supported.
+ */
+template <typename T>
+concept member_enumerable =
+    std::is_aggregate_v<T>
+    and not std::is_array_v<T>
+    and not std::ranges::range<T>;
+
+/**
+ * @brief   Placeholder that is convertible to any member type.
+ */
+struct any_member {
+    template <typename T>
+    operator T() const;                                                                             // NOLINT(google-explicit-constructor) | Implicit conversion is the point
+};
+
+/**
+ * @brief   Count the members of an aggregate by trying to initialize it
+ *          with more and more placeholders.
+ */
+template <typename T, typename ...Members>
+[[nodiscard]] consteval auto member_count() -> std::size_t {
+    if constexpr (requires { T{ Members{ }..., any_member{ } }; }) {
+        return member_count<T, Members..., any_member>();
+    }
+    else {
+        return sizeof...(Members);
+    }
+}
+
+/**
+ * @brief   Tie the members of an aggregate with structured bindings.
+ *
+ * @returns a tuple of references to the members in order of declaration.
+ */
+template <typename T>
+[[nodiscard]] constexpr auto tie_members(T& x) {
+    constexpr auto N = member_count<std::remove_cv_t<T>>();
+    static_assert(N <= MaxAggregateFields, "Too many members to enumerate. Provide a (de)serializer<T> specialization.");
+
+    if constexpr (N == 1) {
+        auto& [m0] = x;
+        return std::tie(m0);
+    }
+    else if constexpr (N == 2) {
+        auto& [m0, m1] = x;
+        return std::tie(m0, m1);
+    }
+    else if constexpr (N == 3) {
+        auto& [m0, m1, m2] = x;
+        return std::tie(m0, m1, m2);
+    }
+    else if constexpr (N == 4) {
+        auto& [m0, m1, m2, m3] = x;
+        return std::tie(m0, m1, m2, m3);
+    }
+    else if constexpr (N == 5) {
+        auto& [m0, m1, m2, m3, m4] = x;
+        return std::tie(m0, m1, m2, m3, m4);
+    }
+    else if constexpr (N == 6) {
+        auto& [m0, m1, m2, m3, m4, m5] = x;
+        return std::tie(m0, m1, m2, m3, m4, m5);
+    }
+    else if constexpr (N == 7) {
+        auto& [m0, m1, m2, m3, m4, m5, m6] = x;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6);
+    }
+    else if constexpr (N == 8) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7] = x;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7);
+    }
+    else if constexpr (N == 9) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8] = x;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8);
+    }
+    else if constexpr (N == 10) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9] = x;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9);
+    }
+    else if constexpr (N == 11) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10] = x;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10);
+    }
+    else if constexpr (N == 12) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11] = x;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11);
+    }
+    else if constexpr (N == 13) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12] = x;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12);
+    }
+    else if constexpr (N == 14) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13] = x;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13);
+    }
+    else if constexpr (N == 15) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14] = x;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14);
+    }
+    else if constexpr (N == 16) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15] = x;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15);
+    }
+    else {
+        return std::tuple<>{ };
+    }
+}
+
+template <typename T>
+struct aggregate_serializer;
+
+template <typename T>
+struct aggregate_deserializer;
+
+/**
+ * @brief   Serialized size of a type if it is known at compile-time.
+ *
+ * A `serializer<T>` specialization can declare its fixed size with a
+ * `static constexpr std::size_t size` member.
+ */
+template <typename T>
+[[nodiscard]] consteval auto static_serialized_size() -> std::optional<std::size_t> {
+    if constexpr (requires { { serializer<T>::size } -> std::convertible_to<std::size_t>; }) {
+        return serializer<T>::size;
+    }
+    else if constexpr (fixed_width_number<T>) {
+        return sizeof(T);
+    }
+    else if constexpr (is_std_array_v<T>) {
+        constexpr auto element = static_serialized_size<typename T::value_type>();
+        return element.has_value() ? std::optional(*element * std::tuple_size_v<T>) : std::nullopt;
+    }
+    else if constexpr (is_std_tuple_v<T> or is_std_pair_v<T>) {
+        return []<std::size_t ...Is>(std::index_sequence<Is...>) -> std::optional<std::size_t> {
+            const auto sizes = std::array<std::optional<std::size_t>, sizeof...(Is)>{
+                static_serialized_size<std::tuple_element_t<Is, T>>()...
+            };
+            if (not std::ranges::all_of(sizes, [](const auto& x) { return x.has_value(); })) {
+                return std::nullopt;
+            }
+            return (std::size_t{ 0 } + ... + *sizes[Is]);
+        }(std::make_index_sequence<std::tuple_size_v<T>>{ });
+    }
+    else if constexpr (member_enumerable<T> and std::is_base_of_v<aggregate_serializer<T>, serializer<T>>) {
+        using members = decltype(tie_members(std::declval<T&>()));
+        return []<std::size_t ...Is>(std::index_sequence<Is...>) -> std::optional<std::size_t> {
+            const auto sizes = std::array<std::optional<std::size_t>, sizeof...(Is)>{
+                static_serialized_size<std::remove_cvref_t<std::tuple_element_t<Is, members>>>()...
+            };
+
+            auto ret = std::size_t{ 0 };
+            for (const auto& size : sizes) {
+                if (not size.has_value()) {
+                    return std::nullopt;
+                }
+                ret += *size;
+            }
+            return ret;
+        }(std::make_index_sequence<std::tuple_size_v<members>>{ });
+    }
+    else {
+        return std::nullopt;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief   Types with a serialized size known at compile-time.
+ */
+template <typename T>
+concept fixed_size_serializable = detail::static_serialized_size<T>().has_value();
+
+/**
+ * @brief   Number of bytes `T` is serialized into.
+ */
+template <fixed_size_serializable T>
+[[nodiscard]] constexpr auto serialized_size() -> std::size_t {
+    return *detail::static_serialized_size<T>();
+}
+
+namespace detail {
+
+/**
+ * @brief   Whether both the serializer and the deserializer of `T` are the
+ *          default ones member by member, i.e., neither is specialized.
+ */
+template <typename T>
+inline constexpr bool default_aggregate_serialization =
+    std::is_base_of_v<aggregate_serializer<T>, serializer<T>>
+    and std::is_base_of_v<aggregate_deserializer<T>, deserializer<T>>;
+
+/**
+ * @brief   Whether the serialized form of a type is the same as its object
+ *          representation in native byte order.
+ *
+ * Holds for unsigned integers and floating point numbers, and arrays and
+ * aggregates of them without padding, e.g., packed structs, and arrays of
+ * those. Types with a `serializer` or `deserializer` specialization are
+ * serialized by them, so they are never copied.
+ */
+template <typename T>
+[[nodiscard]] consteval auto bitwise_serializable() -> bool {
+    if constexpr (fixed_width_number<T>) {
+        return true;
+    }
+    else if constexpr (is_std_array_v<T>) {
+        return bitwise_serializable<typename T::value_type>();
+    }
+    else if constexpr (member_enumerable<T> and default_aggregate_serialization<T> and fixed_size_serializable<T> and std::is_trivially_copyable_v<T>) {
+        using members = decltype(tie_members(std::declval<T&>()));
+        return sizeof(T) == serialized_size<T>()
+           and []<std::size_t ...Is>(std::index_sequence<Is...>) {
+                return (bitwise_serializable<std::remove_cvref_t<std::tuple_element_t<Is, members>>>() and ...);
+            }(std::make_index_sequence<std::tuple_size_v<members>>{ });
+    }
+    else {
+        return false;
+    }
+}
+
+/**
+ * @brief   Serializes aggregates member by member, like the elements of a
+ *          tuple.
+ *
+ * Types with the same layout in memory as serialized are copied at once.
+ */
+template <typename T>
+struct aggregate_serializer {
+    template <endian Endianness, typename Allocator>
+    void operator()(serializer_context<Endianness, Allocator>& ser, const T& x) {
+        if constexpr (not member_enumerable<T>) {
+            static_assert(dependent_false<T>, "Cannot serialize the type. Provide a serializer<T> specialization.");
+        }
+        else if constexpr (Endianness == endian::native and bitwise_serializable<T>()) {
+            ser(data_view<>{ &x, sizeof(T) });
+        }
+        else {
+            std::apply([&ser](const auto& ...members) { (serialize_element(ser, members), ...); }, tie_members(x));
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief   Serializer of type `T`.
+ *
+ * Aggregates are serialized member by member by default. Specialize it for
+ * other types, or to customize the serialization.
+ */
+template <typename T>
+struct serializer : detail::aggregate_serializer<T> { };
+
+namespace detail {
+
+/**
+ * @brief   Serializer that holds a byte array.
+ *
+ * Numbers are written in the byte order given by `Endianness`. In `native`
+ * mode, or if it matches the host's byte order, they are simply copied.
+ *
+ * The underlying vector holding the bytes is automatically resized with a
+ * geometric growth if needed. For performance oriented use cases consider
+ * creating the context with a predefined sized to avoid unnecessary
+ * reallocations. It will still resize if the preallocation is not large enough.
+ * The same context can be reused for many messages by calling `reset()`, which
+ * keeps the allocated buffer.
+ *
+ * The written bytes can be accessed without copying via `view()`, or the buffer
+ * can be moved out with `release()`.
+ *
+ * Spans of integers or floating point numbers (e.g. `std::span<const float>`)
+ * are written in bulk with one reservation, without their number of elements.
+ * Vectors of numbers are written in bulk too, after their number of elements.
+ */
+template <endian Endianness, typename Allocator>
+class serializer_context {
+public:
+    using buffer_type = std::vector<std::byte, Allocator>;
+
+    serializer_context(std::size_t size = 1, const Allocator& alloc = Allocator{ })
+        : m_data(std::max(std::size_t{ 1 }, size), alloc)
+    {}
+
+    /**
+     * @brief   Serialize a value.
+     */
+    template <typename T>
+    void operator()(const T& value) {
+        impl(value);
+    }
+
+    /**
+     * @brief   Return a copy of the serialized data in a byte array.
+     *
+     * If the underlying vector is bigger than the serialized bytes, it will be
+     * truncated.
+     */
+    [[nodiscard]] auto data() const -> bytes {
+        return bytes(m_data.begin(), std::next(m_data.begin(), static_cast<std::ptrdiff_t>(m_offset)));
+    }
+
+    /**
+     * @brief   Non-owning view of the serialized data.
+     *
+     * It is invalidated by any further serialization or `reset()`.
+     */
+    [[nodiscard]] auto view() const -> data_view<Endianness> {
+        return data_view<Endianness>{ m_data.data(), m_offset };
+    }
+
+    /**
+     * @brief   Move out the underlying buffer truncated to the serialized data.
+     *
+     * The context is left empty; it allocates again on the next serialization.
+     */
+    [[nodiscard]] auto release() -> buffer_type {
+        m_data.resize(m_offset);
+        m_offset = 0;
+        return std::exchange(m_data, buffer_type(m_data.get_allocator()));
+    }
+
+    /**
+     * @brief   Start a new serialization keeping the allocated buffer.
+     */
+    void reset() {
+        m_offset = 0;
+    }
+
+    /**
+     * @brief   Number of serialized bytes.
+     */
+    [[nodiscard]] auto size() const -> std::size_t {
+        return m_offset;
+    }
+
+    /**
+     * @brief   Make room for `n` more bytes at once, e.g., before serializing
+     *          many elements of a known size.
+     */
+    void reserve(std::size_t n) {
+        resize_if_needed(n);
+    }
+
+private:
+    buffer_type m_data;
+    std::size_t m_offset = 0;
+
+    template <fixed_width_number T>
+    void impl(const T& x) {
+        resize_if_needed(sizeof(T));
+        store_numbers<Endianness>(cursor(), &x, 1);
+        m_offset += sizeof(T);
+    }
+
+    /**
+     * @brief   Serialize the elements of the span one after another.
+     *
+     * Note: the number of elements is not serialized. Containers go through
+     * their serializer, which writes it.
+     */
+    template <contiguous_number_range Range>
+        requires is_std_span_v<Range>
+    void impl(const Range& xs) {
+        using T = std::ranges::range_value_t<Range>;
+        const auto n = std::ranges::size(xs);
+
+        resize_if_needed(n * sizeof(T));
+        store_numbers<Endianness>(cursor(), std::ranges::data(xs), n);
+        m_offset += n * sizeof(T);
+    }
+
+    /**
+     * @brief   Copy bytes as they are.
+     */
+    template <endian E, bool B>
+    void impl(const data_view<E, B>& x) {
+        if (x.empty()) {
+            return;
+        }
+        resize_if_needed(x.size());
+        std::memcpy(cursor(), x.ptr(), x.size());
+        m_offset += x.size();
+    }
+
+    template <std::integral T>
+    void impl(const varint<T>& x) {
+        resize_if_needed(MaxVarintSize<T>);
+        m_offset += store_varint(cursor(), zigzag_encode(x.value));
+    }
+
+    void impl(std::string_view x) {
+        copy_range(x);
+    }
+
+    void impl(const std::string& x) {
+        copy_range(x);
+    }
+
+    template <typename T>
+    void impl(const T& x) {
+        serializer<T>{ }(*this, x);
+    }
+
+    template <typename Range>
+        requires std::contiguous_iterator<typename Range::iterator>
+            or std::is_array_v<Range>
+    void copy_range(const Range& src) {
+        resize_if_needed(src.size());
+
+        using DT = typename buffer_type::difference_type;
+        std::ranges::copy(data_view{ src }, std::next(std::begin(m_data), static_cast<DT>(m_offset)));
+        m_offset += std::size(src);
+    }
+
+    [[nodiscard]] auto cursor() -> std::byte* {
+        return std::next(m_data.data(), static_cast<std::ptrdiff_t>(m_offset));
+    }
+
+    void resize_if_needed(std::size_t size) {
+        if (m_offset + size > m_data.size()) {
+            m_data.resize(std::max(m_data.size() * 2, m_offset + size));
+        }
+    }
+
+};
+
+} // namespace detail
+
+/**
+ * @brief   Serialize a type into a byte array.
+ */
+template <endian Endianness = endian::big, typename T>
+[[nodiscard]] auto serialize(const T& x, std::size_t size = 1) -> bytes {
+    if constexpr (fixed_size_serializable<T>) {
+        size = std::max(size, serialized_size<T>());
+    }
+    auto ser = detail::serializer_context<Endianness>{ size };
+    ser(x);
+    return ser.release();
+}
+
+namespace detail {
+
+    inline void hex_check(std::string_view str, std::size_t invalid) {
+        if (str.size() % 2 != 0) {
+            throw exception("Invalid hex string: odd length {}", str.size());
+        }
+        if (invalid != std::string_view::npos) {
+            throw exception("Invalid hex string: unexpected character at {}", invalid);
+        }
+    }
+
+} // namespace detail
+
+/**
+ * @brief   Parse hex digits (either case) into bytes.
+ *
+ * @throws  if the length is odd or there is a non-hex character.
+ */
+[[nodiscard]] inline auto from_hex(std::string_view str) -> bytes {
+    detail::hex_check(str, std::string_view::npos);
+
+    auto ret = bytes(str.size() / 2);
+    detail::hex_check(str, detail::hex_decode(ret.data(), str.data(), ret.size()));
+    return ret;
+}
+
+/**
+ * @brief   Parse hex digits (either case) and append the bytes to `ser`.
+ *
+ * @throws  if the length is odd or there is a non-hex character. Bytes
+ *          before the invalid character may have been appended already.
+ */
+template <endian Endianness, typename Allocator>
+void from_hex(std::string_view str, detail::serializer_context<Endianness, Allocator>& ser) {
+    detail::hex_check(str, std::string_view::npos);
+
+    static constexpr std::size_t ChunkSize = 256;
+    auto buffer = std::array<std::byte, ChunkSize>{ };
+
+    for (std::size_t pos = 0; pos < str.size(); pos += 2 * ChunkSize) {
+        const auto length = std::min(ChunkSize, (str.size() - pos) / 2);
+        const auto invalid = detail::hex_decode(buffer.data(), std::next(str.data(), static_cast<std::ptrdiff_t>(pos)), length);
+        detail::hex_check(str, invalid == std::string_view::npos ? invalid : pos + invalid);
+        ser(data_view{ buffer.data(), length });
+    }
+}
+
+namespace detail {
+
+template <endian Endianness = endian::big, bool RuntimeBoundCheck = true>
+class deserializer_context;
+
+} // namespace detail
+
+using deserializer_context = detail::deserializer_context<>;
+using deserializer_context_be = detail::deserializer_context<endian::big>;
+using deserializer_context_le = detail::deserializer_context<endian::little>;
+
+template <typename T>
+struct deserializer;
+
+namespace detail {
+
+/**
+ * @brief   Deserializes aggregates member by member.
+ *
+ * The bounds are checked once for types with a fixed serialized size. Types
+ * with the same layout in memory as serialized are copied at once.
+ */
+template <typename T>
+struct aggregate_deserializer {
+    template <endian Endianness, bool RuntimeBoundCheck>
+    void operator()(deserializer_context<Endianness, RuntimeBoundCheck>& deser, T& x) {
+        if constexpr (not member_enumerable<T>) {
+            static_assert(dependent_false<T>, "Cannot deserialize the type. Provide a deserializer<T> specialization.");
+        }
+        else if constexpr (Endianness == endian::native and bitwise_serializable<T>()) {
+            auto record = deser.take(sizeof(T));
+            std::memcpy(&x, record.view().ptr(), sizeof(T));
+        }
+        else if constexpr (fixed_size_serializable<T>) {
+            auto record = deser.take(serialized_size<T>());
+            std::apply([&record](auto& ...members) { (record(members), ...); }, tie_members(x));
+        }
+        else {
+            std::apply([&deser](auto& ...members) { (deserialize_element(deser, members), ...); }, tie_members(x));
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief   Customization point for reading a type with `deserializer_context`.
+ *
+ * Aggregates are deserialized member by member by default.
+ *
+ * ```cpp
+ * template <>
+ * struct deserializer<data>
+ *     void operator()(deserializer_context& deser, data& x) {
+ *         deser(x.member);
+ *     }
+ * };
+ * ```
+ */
+template <typename T>
+struct deserializer : detail::aggregate_deserializer<T> { };
+
+namespace detail {
+
+/**
+ * @brief   Sequential reader over a `data_view`, the counterpart of `serializer_context`.
+ *
+ * Every read advances the position by the number of bytes consumed.
+ *
+ * Reading a fixed size record field by field would check the bounds for each
+ * field. Use `take(n)` to check the bounds once for the whole record and read
+ * the fields from the returned context, which is not bound checked.
+ *
+ * ```cpp
+ * template <>
+ * struct deserializer<header>
+ *     template <typename Context>
+ *     void operator()(Context& deser, header& x) {
+ *         auto record = deser.take(7);
+ *         record(x.type);
+ *         record(x.length);
+ *         record(x.sequence);
+ *     }
+ * };
+ * ```
+ *
+ * @throws  All reading member functions throw if `RuntimeBoundCheck`
+ *          is turned on, else calls to `assert` (debug mode check)
+ */
+template <endian Endianness, bool RuntimeBoundCheck>
+class deserializer_context {
+public:
+    using view_type = data_view<Endianness, RuntimeBoundCheck>;
+
+    [[nodiscard]] deserializer_context(view_type data)
+        : m_data(data)
+    {}
+
+    /**
+     * @brief   Read a value and advance the position.
+     */
+    template <typename T>
+    void operator()(T& value) {
+        impl(value);
+    }
+
+    /**
+     * @brief   Read consecutive numbers into `values` and advance the position.
+     */
+    template <fixed_width_number T, std::size_t Extent>
+    void operator()(std::span<T, Extent> values) {
+        m_data.as_numbers(m_pos, values);
+        m_pos += values.size_bytes();
+    }
+
+    /**
+     * @brief   Check the bounds once for the next `n` bytes, then advance past them.
+     *
+     * @returns a context over the `n` bytes without runtime bound checks.
+     */
+    [[nodiscard]] auto take(std::size_t n) -> deserializer_context<Endianness, false> {
+        require(n);
+        const auto ret = data_view<Endianness, false>{ cursor(), n };
+        m_pos += n;
+        return { ret };
+    }
+
+    /**
+     * @brief   Same as `take(count * size)` for `count` elements of `size`
+     *          bytes, e.g., after reading the length of a container.
+     *
+     * An overflowing `count` is reported as one byte more than available.
+     */
+    [[nodiscard]] auto take(std::size_t count, std::size_t size) -> deserializer_context<Endianness, false> {
+        const auto fits = size == 0 or count <= std::numeric_limits<std::size_t>::max() / size;
+        return take(fits ? count * size : remaining() + 1);
+    }
+
+    /**
+     * @brief   Advance the position without reading.
+     */
+    void skip(std::size_t n) {
+        require(n);
+        m_pos += n;
+    }
+
+    [[nodiscard]] auto pos()       const -> std::size_t { return m_pos; }
+    [[nodiscard]] auto remaining() const -> std::size_t { return m_data.size() - m_pos; }
+    [[nodiscard]] auto empty()     const -> bool        { return remaining() == 0; }
 
-        return ret;
+    /**
+     * @brief   The unread part of the data.
+     */
+    [[nodiscard]] auto view() const -> view_type {
+        return m_data.subview(m_pos);
     }
 
-    [[nodiscard]]
-    auto as_hex_string() const -> std::string {
-        return as_hex_string(0, size());
-    }
+private:
+    view_type m_data;
+    std::size_t m_pos = 0;
 
-    [[nodiscard]]
-    auto to_vec() const -> bytes {
-        auto ret = bytes(size());
+    template <fixed_width_number T>
+    void impl(T& x) {
+        x = m_data.template as_number<T>(m_pos);
+        m_pos += sizeof(T);
+    }
 
-        std::ranges::copy(
-            std::begin(m_data),
-            std::end(m_data),
-            std::begin(ret)
-        );
+    template <std::integral T>
+    void impl(varint<T>& x) {
+        const auto [value, size] = m_data.template as_varint<T>(m_pos);
+        x.value = value;
+        m_pos += size;
+    }
 
-        return ret;
+    template <typename T>
+    void impl(T& x) {
+        deserializer<T>{ }(*this, x);
     }
 
-private:
-    std::span<const std::byte> m_data;
+    [[nodiscard]] auto cursor() const -> const std::byte* {
+        return std::next(m_data.ptr(), static_cast<std::ptrdiff_t>(m_pos));
+    }
 
-    void boundary_check(std::size_t pos, std::size_t length) const {
+    void require(std::size_t n) const {
         if constexpr (RuntimeBoundCheck) {
-            if (size() < pos + length) {
+            if (remaining() < n) {
                 throw exception(
                     "Out of bounds access: {}",
-                    detail::data_cursor{ pos, length, size() }
+                    detail::data_cursor{ m_pos, n, m_data.size() }
                 );
             }
         }
         else {
-            nova_assert(pos + length <= size());
+            nova_assert(n <= remaining());
         }
     }
 
-    void boundary_check_bit(std::size_t pos, std::size_t length) const {
-        if constexpr (RuntimeBoundCheck) {
-            if (size() * Byte < pos + length) {
-                throw exception(
-                    "Out of bounds access: {} (bits)",
-                    detail::data_cursor{ pos, length, size() * Byte }
-                );
-            }
-        }
-        else {
-            nova_assert(pos + length <= size() * Byte);
-        }
-    }
 };
 
 } // namespace detail
 
-using data_view = detail::data_view<>;
-using data_view_be = detail::data_view<endian::big>;
-using data_view_le = detail::data_view<endian::little>;
+/**
+ * @brief   Deserialize a type from binary data.
+ */
+template <typename T, endian Endianness = endian::big, bool RuntimeBoundCheck = true>
+[[nodiscard]] auto deserialize(detail::data_view<Endianness, RuntimeBoundCheck> data) -> T {
+    auto ret = T{ };
+    auto deser = detail::deserializer_context<Endianness, RuntimeBoundCheck>{ data };
+    deser(ret);
+    return ret;
+}
 
-namespace literals {
+namespace detail {
 
-    [[nodiscard]] inline
-    auto operator""_data(const char* str, std::size_t n) noexcept {
-        return data_view{ str, n };
+/**
+ * @brief   Types written without their length on their own, which need a
+ *          length prefix as elements of containers and members of aggregates.
+ */
+template <typename T>
+concept length_prefixed_element =
+    std::same_as<T, std::string>
+    or std::same_as<T, std::string_view>
+    or (contiguous_number_range<T> and is_std_span_v<T>);
+
+/**
+ * @brief   Serialize an element of a container.
+ */
+template <endian Endianness, typename Allocator, typename T>
+void serialize_element(serializer_context<Endianness, Allocator>& ser, const T& x) {
+    if constexpr (length_prefixed_element<T>) {
+        ser(varint{ std::ranges::size(x) });
     }
+    ser(x);
+}
 
-} // namespace literals
+/**
+ * @brief   Deserialize an element of a container.
+ */
+template <endian Endianness, bool RuntimeBoundCheck, typename T>
+void deserialize_element(deserializer_context<Endianness, RuntimeBoundCheck>& deser, T& x) {
+    if constexpr (std::same_as<T, std::string>) {
+        auto length = varint<std::size_t>{ };
+        deser(length);
+        x.assign(deser.take(length.value).view().char_ptr(), length.value);
+    }
+    else {
+        deser(x);
+    }
+}
 
-class serializer_context;
+/**
+ * @brief   Serialize consecutive elements without their count.
+ *
+ * Numbers and types with the same layout in memory as serialized are written
+ * at once, other fixed size types after a single reservation.
+ */
+template <endian Endianness, typename Allocator, typename T>
+void serialize_elements(serializer_context<Endianness, Allocator>& ser, std::span<const T> xs) {
+    if constexpr (fixed_width_number<T>) {
+        ser(xs);
+    }
+    else if constexpr (Endianness == endian::native and bitwise_serializable<T>()) {
+        ser(data_view<>{ xs.data(), xs.size_bytes() });
+    }
+    else {
+        if constexpr (fixed_size_serializable<T>) {
+            ser.reserve(xs.size() * serialized_size<T>());
+        }
+        for (const auto& x : xs) {
+            serialize_element(ser, x);
+        }
+    }
+}
 
-template <typename T>
-struct serializer {
-    void operator()(serializer_context&, const T&) {
-        static_assert(dependent_false<T>, "Cannot serialize the type. Provide a serializer<T> specialization.");
+/**
+ * @brief   Deserialize consecutive elements into `xs`.
+ *
+ * The bounds are checked once for fixed size types.
+ */
+template <endian Endianness, bool RuntimeBoundCheck, typename T>
+void deserialize_elements(deserializer_context<Endianness, RuntimeBoundCheck>& deser, std::span<T> xs) {
+    if constexpr (fixed_width_number<T>) {
+        deser(xs);
     }
-};
+    else if constexpr (Endianness == endian::native and bitwise_serializable<T>()) {
+        auto records = deser.take(xs.size(), sizeof(T));
+        if (not xs.empty()) {
+            std::memcpy(xs.data(), records.view().ptr(), xs.size_bytes());
+        }
+    }
+    else if constexpr (fixed_size_serializable<T>) {
+        auto records = deser.take(xs.size(), serialized_size<T>());
+        for (auto& x : xs) {
+            records(x);
+        }
+    }
+    else {
+        for (auto& x : xs) {
+            deserialize_element(deser, x);
+        }
+    }
+}
 
 /**
- * @brief   Serializer that holds a byte array.
+ * @brief   Deserialize `count` elements into a vector.
  *
- * The underlying vector holding the bytes is automatically resized with a
- * geometric growth if needed. For performance oriented use cases consider
- * creating the context with a predefined sized to avoid unnecessary
- * reallocations. It will still resize if the preallocation is not large enough.
+ * For fixed size types, the bounds are checked before allocating.
  */
-class serializer_context {
-    static constexpr auto Byte = 8;
+template <endian Endianness, bool RuntimeBoundCheck, typename T, typename Allocator>
+void deserialize_elements(deserializer_context<Endianness, RuntimeBoundCheck>& deser, std::vector<T, Allocator>& xs, std::size_t count) {
+    if constexpr (fixed_size_serializable<T>) {
+        auto records = deser.take(count, serialized_size<T>());
+        xs.resize(count);
+        deserialize_elements(records, std::span(xs));
+    }
+    else {
+        xs.clear();
+        xs.reserve(std::min(count, deser.remaining()));
+        for (std::size_t i = 0; i < count; ++i) {
+            deserialize_element(deser, xs.emplace_back());
+        }
+    }
+}
 
-public:
-    serializer_context(std::size_t size = 1)
-        : m_data(std::min(std::size_t{ 1 }, size))
-    {}
+/**
+ * @brief   Serializes tuple-like types element by element.
+ */
+template <typename T>
+struct tuple_serializer {
+    template <endian Endianness, typename Allocator>
+    void operator()(serializer_context<Endianness, Allocator>& ser, const T& x) {
+        if constexpr (fixed_size_serializable<T>) {
+            ser.reserve(serialized_size<T>());
+        }
+        std::apply([&ser](const auto& ...xs) { (serialize_element(ser, xs), ...); }, x);
+    }
+};
 
-    /**
-     * @brief   Serialize a value (Big-Endian).
-     */
-    template <typename T>
-    void operator()(T value) {
-        impl(value);
+/**
+ * @brief   Deserializes tuple-like types element by element.
+ */
+template <typename T>
+struct tuple_deserializer {
+    template <endian Endianness, bool RuntimeBoundCheck>
+    void operator()(deserializer_context<Endianness, RuntimeBoundCheck>& deser, T& x) {
+        if constexpr (fixed_size_serializable<T>) {
+            auto record = deser.take(serialized_size<T>());
+            std::apply([&record](auto& ...xs) { (record(xs), ...); }, x);
+        }
+        else {
+            std::apply([&deser](auto& ...xs) { (deserialize_element(deser, xs), ...); }, x);
+        }
     }
+};
 
-    /**
-     * @brief   Return a copy of the serialized data in a byte array.
-     *
-     * If the underlying vector is bigger than the serialized bytes, it will be
-     * truncated.
-     */
-    [[nodiscard]] auto data() const -> bytes {
-        auto ret = m_data;
-        ret.resize(m_offset);
-        return ret;
+/**
+ * @brief   Position, length and size of the data for errors in a deserializer.
+ */
+template <endian Endianness, bool RuntimeBoundCheck>
+[[nodiscard]] auto read_cursor(const deserializer_context<Endianness, RuntimeBoundCheck>& deser, std::size_t from) -> data_cursor {
+    return { from, deser.pos() - from, deser.pos() + deser.remaining() };
+}
+
+} // namespace detail
+
+/**
+ * @brief   A vector is written as its number of elements as a varint, then
+ *          its elements.
+ */
+template <typename T, typename Allocator>
+    requires (not std::same_as<T, bool>)
+struct serializer<std::vector<T, Allocator>> {
+    template <endian Endianness, typename A>
+    void operator()(detail::serializer_context<Endianness, A>& ser, const std::vector<T, Allocator>& xs) {
+        ser(varint{ xs.size() });
+        detail::serialize_elements(ser, std::span(xs));
     }
+};
 
-private:
-    bytes m_data;
-    std::size_t m_offset = 0;
+template <typename T, typename Allocator>
+    requires (not std::same_as<T, bool>)
+struct deserializer<std::vector<T, Allocator>> {
+    template <endian Endianness, bool RuntimeBoundCheck>
+    void operator()(detail::deserializer_context<Endianness, RuntimeBoundCheck>& deser, std::vector<T, Allocator>& xs) {
+        auto count = varint<std::size_t>{ };
+        deser(count);
+        detail::deserialize_elements(deser, xs, count.value);
+    }
+};
 
-    template <std::unsigned_integral T>
-    void impl(const T& x) {
-        resize_if_needed(sizeof(T));
+/**
+ * @brief   An array is written as its elements; its size is known.
+ */
+template <typename T, std::size_t N>
+struct serializer<std::array<T, N>> {
+    template <endian Endianness, typename Allocator>
+    void operator()(detail::serializer_context<Endianness, Allocator>& ser, const std::array<T, N>& xs) {
+        detail::serialize_elements(ser, std::span<const T>(xs));
+    }
+};
 
-        for (std::size_t i = 0; i < sizeof(T); ++i) {
-            const auto shift = (sizeof(T) - i - 1) * Byte;
-            const auto mask = static_cast<T>(T{ 0xFF } << shift);
+template <typename T, std::size_t N>
+struct deserializer<std::array<T, N>> {
+    template <endian Endianness, bool RuntimeBoundCheck>
+    void operator()(detail::deserializer_context<Endianness, RuntimeBoundCheck>& deser, std::array<T, N>& xs) {
+        detail::deserialize_elements(deser, std::span<T>(xs));
+    }
+};
 
-            m_data[m_offset] = std::byte{ static_cast<std::uint8_t>((x & mask) >> shift) };
-            ++m_offset;
+/**
+ * @brief   An optional is written as a byte of 0 (empty) or 1, then its value.
+ */
+template <typename T>
+struct serializer<std::optional<T>> {
+    template <endian Endianness, typename Allocator>
+    void operator()(detail::serializer_context<Endianness, Allocator>& ser, const std::optional<T>& x) {
+        ser(static_cast<std::uint8_t>(x.has_value()));
+        if (x.has_value()) {
+            detail::serialize_element(ser, *x);
         }
     }
+};
 
-    void impl(std::string_view x) {
-        copy_range(x);
+template <typename T>
+struct deserializer<std::optional<T>> {
+    /**
+     * @throws  if the flag is neither 0 nor 1.
+     */
+    template <endian Endianness, bool RuntimeBoundCheck>
+    void operator()(detail::deserializer_context<Endianness, RuntimeBoundCheck>& deser, std::optional<T>& x) {
+        const auto from = deser.pos();
+        auto flag = std::uint8_t{ };
+        deser(flag);
+
+        if (flag > 1) {
+            throw exception("Invalid optional flag {}: {}", flag, detail::read_cursor(deser, from));
+        }
+        if (flag == 0) {
+            x.reset();
+            return;
+        }
+        detail::deserialize_element(deser, x.emplace());
     }
+};
 
-    void impl(const std::string& x) {
-        copy_range(x);
+/**
+ * @brief   A variant is written as the index of its alternative as a varint,
+ *          then its value.
+ */
+template <typename ...Ts>
+struct serializer<std::variant<Ts...>> {
+    template <endian Endianness, typename Allocator>
+    void operator()(detail::serializer_context<Endianness, Allocator>& ser, const std::variant<Ts...>& x) {
+        nova_assert(not x.valueless_by_exception());
+        ser(varint{ x.index() });
+        std::visit([&ser](const auto& value) { detail::serialize_element(ser, value); }, x);
     }
+};
 
-    template <typename T>
-    void impl(const T& x) {
-        serializer<T>{ }(*this, x);
+template <typename ...Ts>
+struct deserializer<std::variant<Ts...>> {
+    /**
+     * @throws  if the index is not of an alternative.
+     */
+    template <endian Endianness, bool RuntimeBoundCheck>
+    void operator()(detail::deserializer_context<Endianness, RuntimeBoundCheck>& deser, std::variant<Ts...>& x) {
+        const auto from = deser.pos();
+        auto index = varint<std::size_t>{ };
+        deser(index);
+
+        if (index.value >= sizeof...(Ts)) {
+            throw exception("Invalid variant index {}: {}", index.value, detail::read_cursor(deser, from));
+        }
+        [&]<std::size_t ...Is>(std::index_sequence<Is...>) {
+            std::ignore = ((index.value == Is and (detail::deserialize_element(deser, x.template emplace<Is>()), true)) or ...);
+        }(std::index_sequence_for<Ts...>{ });
     }
+};
 
-    template <typename Range>
-        requires std::contiguous_iterator<typename Range::iterator>
-            or std::is_array_v<Range>
-    void copy_range(const Range& src) {
-        resize_if_needed(src.size());
+/**
+ * @brief   Tuples and pairs are written element by element.
+ */
+template <typename ...Ts>
+struct serializer<std::tuple<Ts...>> : detail::tuple_serializer<std::tuple<Ts...>> { };
 
-        using DT = bytes::difference_type;
-        std::ranges::copy(data_view{ src }, std::next(std::begin(m_data), static_cast<DT>(m_offset)));
-        m_offset += std::size(src);
+template <typename ...Ts>
+struct deserializer<std::tuple<Ts...>> : detail::tuple_deserializer<std::tuple<Ts...>> { };
+
+template <typename T1, typename T2>
+struct serializer<std::pair<T1, T2>> : detail::tuple_serializer<std::pair<T1, T2>> { };
+
+template <typename T1, typename T2>
+struct deserializer<std::pair<T1, T2>> : detail::tuple_deserializer<std::pair<T1, T2>> { };
+
+/**
+ * @brief   A map is written as its number of elements as a varint, then all
+ *          the keys, then all the values, each in bulk if possible.
+ */
+template <typename Key, typename T, typename Compare>
+struct serializer<flat_map<Key, T, Compare>> {
+    template <endian Endianness, typename Allocator>
+    void operator()(detail::serializer_context<Endianness, Allocator>& ser, const flat_map<Key, T, Compare>& x) {
+        ser(varint{ x.size() });
+        detail::serialize_elements(ser, std::span(x.keys()));
+        detail::serialize_elements(ser, std::span(x.values()));
     }
+};
 
-    void resize_if_needed(std::size_t size) {
-        while (m_offset + size > m_data.size()) {
-            m_data.resize(m_data.size() * 2);
+template <typename Key, typename T, typename Compare>
+struct deserializer<flat_map<Key, T, Compare>> {
+    /**
+     * @throws  if the keys are not sorted or not unique.
+     */
+    template <endian Endianness, bool RuntimeBoundCheck>
+    void operator()(detail::deserializer_context<Endianness, RuntimeBoundCheck>& deser, flat_map<Key, T, Compare>& x) {
+        const auto from = deser.pos();
+        auto count = varint<std::size_t>{ };
+        deser(count);
+
+        auto keys = typename flat_map<Key, T, Compare>::key_container_type{ };
+        auto values = typename flat_map<Key, T, Compare>::mapped_container_type{ };
+        detail::deserialize_elements(deser, keys, count.value);
+
+        const auto unordered = std::ranges::adjacent_find(keys, [](const Key& a, const Key& b) { return not Compare{ }(a, b); });
+        if (unordered != keys.end()) {
+            throw exception("Invalid map: keys are not sorted or not unique: {}", detail::read_cursor(deser, from));
         }
+
+        detail::deserialize_elements(deser, values, count.value);
+        x = flat_map<Key, T, Compare>{ sorted_unique, std::move(keys), std::move(values) };
     }
+};
 
+/**
+ * @brief   How a transfer from or to a file descriptor ended.
+ */
+enum class io_status : std::uint8_t {
+    ok,
+    would_block,            // `EAGAIN`: no more data or space for now (non-blocking descriptors).
+    eof,                    // End of file or the peer closed the connection.
 };
 
 /**
- * @brief   Serialize a type into a byte array.
+ * @brief   Number of bytes transferred and how the transfer ended.
  */
-template <typename T>
-[[nodiscard]] auto serialize(const T& x, std::size_t size = 1) -> bytes {
-    auto ser = serializer_context{ size };
-    ser(x);
-    return ser.data();
-}
+struct io_result {
+    std::size_t bytes = 0;
+    io_status status = io_status::ok;
+};
+
+#ifdef NOVA_LINUX
+
+namespace detail {
+
+    /**
+     * @brief   `readv` retried on `EINTR`.
+     */
+    [[nodiscard]] inline auto read_fd(int fd, std::span<const iovec> iov) -> expected<io_result, error> {
+        while (true) {
+            const auto n = ::readv(fd, iov.data(), static_cast<int>(iov.size()));
+            if (n > 0) {
+                return io_result{ static_cast<std::size_t>(n), io_status::ok };
+            }
+            if (n == 0) {
+                return io_result{ 0, io_status::eof };
+            }
+            if (errno == EAGAIN) {                                                                 // Same as `EWOULDBLOCK` on Linux
+                return io_result{ 0, io_status::would_block };
+            }
+            if (errno != EINTR) {
+                return { unexpect, fmt::format("Cannot read from file descriptor {}: {}", fd, std::system_category().message(errno)) };
+            }
+        }
+    }
+
+    /**
+     * @brief   `writev` retried on `EINTR`.
+     *
+     * Writing nothing counts as would block, so that the callers writing
+     * until the data is gone do not spin.
+     */
+    [[nodiscard]] inline auto write_fd(int fd, std::span<const iovec> iov) -> expected<io_result, error> {
+        while (true) {
+            const auto n = ::writev(fd, iov.data(), static_cast<int>(iov.size()));
+            if (n > 0) {
+                return io_result{ static_cast<std::size_t>(n), io_status::ok };
+            }
+            if (n == 0) {
+                return io_result{ 0, io_status::would_block };
+            }
+            if (errno == EAGAIN) {                                                                 // Same as `EWOULDBLOCK` on Linux
+                return io_result{ 0, io_status::would_block };
+            }
+            if (errno != EINTR) {
+                return { unexpect, fmt::format("Cannot write to file descriptor {}: {}", fd, std::system_category().message(errno)) };
+            }
+        }
+    }
+
+    /**
+     * @brief   Write all of `buffer.view()` into `fd`, consuming what is written,
+     *          until the buffer is empty or the descriptor would block.
+     */
+    template <typename Buffer>
+    [[nodiscard]] auto drain_buffer(Buffer& buffer, int fd) -> expected<io_result, error> {
+        auto ret = io_result{ };
+
+        while (not buffer.empty()) {
+            const auto data = buffer.view();
+            const auto iov = iovec{ const_cast<std::byte*>(data.ptr()), data.size() };             // NOLINT(cppcoreguidelines-pro-type-const-cast) | `writev` does not modify the data
+            const auto result = write_fd(fd, std::span(&iov, 1));
+            if (not result.has_value()) {
+                return result;
+            }
+
+            buffer.consume(result->bytes);
+            ret.bytes += result->bytes;
+            if (result->status != io_status::ok) {
+                ret.status = result->status;
+                break;
+            }
+        }
+        return ret;
+    }
+
+} // namespace detail
+
+#endif // NOVA_LINUX
 
 /**
  * @brief   A stream buffer for binary data integrated with `data_view` (Big-Endian).
@@ -615,6 +2504,13 @@ template <typename T>
  * }
  * ```
  *
+ * Or directly with file descriptors (Linux):
+ *
+ * ```
+ * auto received = buf.fill_from(socket);
+ * auto sent = buf.drain_to(socket);
+ * ```
+ *
  * Six pointers are used to keep track of read and write area of the buffer.
  * - `eback`: Beginning of get area.
  * - `gptr`: Current byte of get area.
@@ -633,6 +2529,7 @@ public:
 private:
     using base = std::basic_streambuf<std::byte>;
     static constexpr difference_type DefaultBufferDelta = 128;
+    static constexpr std::size_t FillReadSize = 64 * 1024;
 
 public:
 
@@ -701,6 +2598,48 @@ public:
         // return r;
     // }
 
+#ifdef NOVA_LINUX
+    /**
+     * @brief   Read from a file descriptor with a single `readv` call.
+     *
+     * Data is read directly into the free space of the buffer. The free space
+     * is grown to 64 KiB before, or to the maximum size if that is smaller.
+     * It reads nothing if the buffer is full.
+     *
+     * @returns the number of bytes read, and whether the descriptor would
+     *          block or reached its end; an error for other failures.
+     */
+    [[nodiscard]] auto fill_from(int fd) -> expected<io_result, error> {
+        const auto capacity = static_cast<std::size_t>(m_max_size) - size();
+        if (capacity == 0) {
+            return io_result{ };
+        }
+        std::ignore = reserve(static_cast<difference_type>(std::min(capacity, FillReadSize)));
+
+        const auto iov = iovec{ base::pptr(), static_cast<std::size_t>(std::distance(base::pptr(), base::epptr())) };
+        auto result = detail::read_fd(fd, std::span(&iov, 1));
+        if (result.has_value()) {
+            base::pbump(static_cast<int>(result->bytes));
+        }
+        return result;
+    }
+
+    /**
+     * @brief   Write the unread data into a file descriptor with `writev`,
+     *          consuming what is written.
+     *
+     * Partial writes are continued until the buffer is empty or the
+     * descriptor would block.
+     *
+     * @returns the number of bytes written, and whether the descriptor would
+     *          block; an error for other failures (the bytes written before
+     *          are consumed).
+     */
+    [[nodiscard]] auto drain_to(int fd) -> expected<io_result, error> {
+        return detail::drain_buffer(*this, fd);
+    }
+#endif
+
     /**
      * @brief   Consume everything, effectively clearing the buffer.
      *
@@ -838,15 +2777,12 @@ public:
 
     template <typename FmtContext>
     auto format(nova::data_view data, FmtContext& ctx) const {
-        if (is_printable(data)) {
+        if (data.is_printable()) {
             return fmt::format_to(ctx.out(), "{}", data.as_string());
         }
-        return fmt::format_to(ctx.out(), "x{}", data.as_hex_string());
-    }
-
-private:
-    [[nodiscard]] static auto is_printable(nova::data_view data) -> bool {
-        return not std::ranges::any_of(data, [](auto b) { return not nova::is_printable(b); });
+        auto out = ctx.out();
+        *out++ = 'x';
+        return data.format_hex(out);
     }
 
 };
@@ -7,13 +7,30 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#ifdef NOVA_LINUX
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 #include <array>
+#include <bit>
+#include <cmath>
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
+#include <iterator>
 #include <limits>
+#include <memory_resource>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
 
 using namespace nova::literals;
 using namespace nova::units::literals;
@@ -50,6 +67,18 @@ TEST(CharTraitsByte, Find) {
 
     EXPECT_EQ(Trait::find(xs.data(), 3, std::byte{ 0x03 }), &xs[2]);
     EXPECT_EQ(Trait::find(xs.data(), 2, std::byte{ 0x03 }), nullptr);
+    EXPECT_EQ(Trait::find(xs.data(), 0, std::byte{ 0x01 }), nullptr);
+}
+
+TEST(CharTraitsByte, ConstantEvaluated) {
+    using Trait = std::char_traits<std::byte>;
+
+    static constexpr auto xs = std::to_array<std::byte>({ std::byte{ 0x01 }, std::byte{ 0x02 } });
+    static constexpr auto ys = std::to_array<std::byte>({ std::byte{ 0x01 }, std::byte{ 0x03 } });
+
+    static_assert(Trait::compare(xs.data(), ys.data(), 2) == -1);
+    static_assert(Trait::compare(xs.data(), ys.data(), 1) == 0);
+    static_assert(Trait::find(xs.data(), 2, std::byte{ 0x02 }) == &xs[1]);
 }
 
 TEST(CharTraitsByte, NotEof) {
@@ -116,6 +145,97 @@ TEST(DataView, SignedNumbers) {
     EXPECT_EQ(nova::data_view("\x80\x01"sv).as_number<std::int16_t>(0), -32767);
 }
 
+template <typename T>
+class DataViewBulk : public testing::Test {};
+
+using BulkTypes = testing::Types<std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t, std::int16_t>;
+TYPED_TEST_SUITE(DataViewBulk, BulkTypes);
+
+TYPED_TEST(DataViewBulk, InterpretAsNumbers) {
+    using T = TypeParam;
+    static constexpr auto Count = std::size_t{ 37 };
+    static constexpr auto Offset = std::size_t{ 3 };
+
+    auto data = std::vector<unsigned char>(Offset + Count * sizeof(T));
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<unsigned char>(i * 7 + 1);
+    }
+
+    const auto view_be = nova::data_view(data);
+    const auto view_le = nova::data_view_le(data);
+    auto xs_be = std::vector<T>(Count);
+    auto xs_le = std::vector<T>(Count);
+    view_be.as_numbers(Offset, std::span(xs_be));
+    view_le.as_numbers(Offset, std::span(xs_le));
+
+    for (std::size_t i = 0; i < Count; ++i) {
+        const auto pos = Offset + i * sizeof(T);
+        EXPECT_EQ(xs_be[i], view_be.template as_number<T>(pos, sizeof(T)));
+        EXPECT_EQ(xs_le[i], view_le.template as_number<T>(pos, sizeof(T)));
+        EXPECT_EQ(xs_be[i], view_be.template as_number<T>(pos));
+        EXPECT_EQ(xs_le[i], view_le.template as_number<T>(pos));
+    }
+}
+
+TEST(DataView, InterpretAsFloatingPoint) {
+    static constexpr auto data = std::to_array<unsigned char>({
+        0x3F, 0xC0, 0x00, 0x00,
+        0xC0, 0x09, 0x21, 0xFB, 0x54, 0x44, 0x2D, 0x18,
+        0x7F, 0xC0, 0x12, 0x34,
+    });
+    const auto view = nova::data_view(data);
+
+    EXPECT_EQ(view.as_number<float>(0), 1.5F);
+    EXPECT_EQ(view.as_number<double>(4), -3.141592653589793);
+    EXPECT_EQ(std::bit_cast<std::uint32_t>(view.as_number<float>(12)), 0x7FC0'1234);               // NaN payload is kept
+    EXPECT_EQ(nova::data_view_le(data).as_number<float>(0), std::bit_cast<float>(0x0000'C03FU));
+    EXPECT_THROWN_MESSAGE(std::ignore = view.as_number<double>(12), "Out of bounds access: Pos=12 Len=8 End=20 \\(Size=16\\)");
+}
+
+template <typename T>
+class DataViewBulkFloatingPoint : public testing::Test { };
+
+using BulkFloatingPointTypes = testing::Types<float, double>;
+TYPED_TEST_SUITE(DataViewBulkFloatingPoint, BulkFloatingPointTypes);
+
+TYPED_TEST(DataViewBulkFloatingPoint, InterpretAsNumbers) {
+    using T = TypeParam;
+    using U = nova::detail::byteswap_type_t<T>;
+    static constexpr auto Count = std::size_t{ 37 };
+    static constexpr auto Offset = std::size_t{ 3 };
+
+    auto data = std::vector<unsigned char>(Offset + Count * sizeof(T));
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<unsigned char>(i * 7 + 1);
+    }
+
+    const auto view_be = nova::data_view(data);
+    const auto view_le = nova::data_view_le(data);
+    auto xs_be = std::vector<T>(Count);
+    auto xs_le = std::vector<T>(Count);
+    view_be.as_numbers(Offset, std::span(xs_be));
+    view_le.as_numbers(Offset, std::span(xs_le));
+
+    for (std::size_t i = 0; i < Count; ++i) {
+        const auto pos = Offset + i * sizeof(T);
+        EXPECT_EQ(std::bit_cast<U>(xs_be[i]), view_be.template as_number<U>(pos));
+        EXPECT_EQ(std::bit_cast<U>(xs_le[i]), view_le.template as_number<U>(pos));
+        EXPECT_EQ(std::bit_cast<U>(xs_be[i]), std::bit_cast<U>(view_be.template as_number<T>(pos)));
+    }
+}
+
+TEST(DataView, InterpretAsNumbers_OutOfBounds) {
+    const auto data = std::vector<unsigned char>{ 0x01, 0x02, 0x03 };
+    auto xs = std::array<std::uint16_t, 2>{ };
+
+    EXPECT_THAT(
+        [&]{ nova::data_view(data).as_numbers(0, std::span(xs)); },
+        testing::ThrowsMessage<nova::exception>(
+            testing::HasSubstr("Out of bounds access: Pos=0 Len=4 End=4 (Size=3)")
+        )
+    );
+}
+
 TEST(DataView, InterpretAsString) {
     static constexpr auto data = "\x61\x62\x63"sv;
     const auto view = nova::data_view(data);
@@ -127,6 +247,81 @@ TEST(DataView, InterpretAsDynamicString) {
     EXPECT_EQ(nova::data_view(data).as_dyn_string(0), "abcd");
 }
 
+TEST(DataView, InterpretAsDynamicString_VarintLength) {
+    auto data = std::string(200, 'a');
+    data.insert(0, "\xC8\x01");
+    EXPECT_EQ(nova::data_view(data).as_dyn_string(0, nova::varint_length), std::string(200, 'a'));
+
+    static constexpr auto truncated = "\x04\x61\x62"sv;
+    EXPECT_THROWN_MESSAGE(
+        std::ignore = nova::data_view(truncated).as_dyn_string(0, nova::varint_length),
+        "Out of bounds access"
+    );
+}
+
+TEST(DataView, InterpretAsVarint) {
+    // Padded to exercise the word-at-a-time path too.
+    for (const auto padding : { ""sv, "\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF"sv }) {
+        const auto data = std::string("\x00\x7F\x80\x01\xAC\x02\xFF\xFF\xFF\xFF\x0F", 11) + std::string(padding);
+        const auto view = nova::data_view(data);
+
+        EXPECT_EQ(view.as_varint<std::uint32_t>(0).value, 0);
+        EXPECT_EQ(view.as_varint<std::uint32_t>(1).value, 127);
+        EXPECT_EQ(view.as_varint<std::uint32_t>(2).value, 128);
+        EXPECT_EQ(view.as_varint<std::uint32_t>(2).size, 2);
+        EXPECT_EQ(view.as_varint<std::uint32_t>(4).value, 300);
+        EXPECT_EQ(view.as_varint<std::uint32_t>(6).value, std::numeric_limits<std::uint32_t>::max());
+        EXPECT_EQ(view.as_varint<std::uint32_t>(6).size, 5);
+        EXPECT_EQ(view.as_varint<std::int32_t>(1).value, -64);
+        EXPECT_EQ(view.as_varint<std::int32_t>(2).value, 64);
+    }
+
+    static constexpr auto max = "\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x01"sv;
+    EXPECT_EQ(nova::data_view(max).as_varint(0).value, std::numeric_limits<std::uint64_t>::max());
+    EXPECT_EQ(nova::data_view(max).as_varint(0).size, 10);
+}
+
+TEST(DataView, InterpretAsVarint_Invalid) {
+    static constexpr auto truncated = "\x80\x80"sv;
+    static constexpr auto too_long = "\x80\x80\x80\x80\x80\x01\x00\x00"sv;
+    static constexpr auto too_big = "\x80\x02"sv;
+    static constexpr auto beyond_64_bits = "\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x02"sv;
+
+    EXPECT_THAT(
+        []{ std::ignore = nova::data_view(truncated).as_varint(0); },
+        testing::ThrowsMessage<nova::exception>(
+            testing::HasSubstr("Invalid varint: Pos=0 Len=2 End=2 (Size=2)")
+        )
+    );
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::data_view(too_long).as_varint<std::uint32_t>(0), "Invalid varint");
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::data_view(too_big).as_varint<std::uint8_t>(0), "Invalid varint");
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::data_view(beyond_64_bits).as_varint(0), "Invalid varint: Pos=0 Len=10");
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::data_view(too_big).as_varint(2), "Out of bounds access");
+    EXPECT_EQ(nova::data_view(too_big).as_varint<std::uint16_t>(0).value, 256);
+}
+
+TEST(DataView, InterpretAsVarints) {
+    auto values = std::vector<std::int64_t>{ };
+    for (std::int64_t i = -20; i < 20; ++i) {
+        values.push_back(i);
+    }
+    for (std::int64_t i = 1; i < 64; ++i) {
+        values.push_back(i % 2 == 0 ? (std::int64_t{ 1 } << i) : -(std::int64_t{ 1 } << (i - 1)));
+    }
+
+    auto ser = nova::serializer_context{ };
+    for (const auto x : values) {
+        ser(nova::varint{ x });
+    }
+
+    auto xs = std::vector<std::int64_t>(values.size());
+    EXPECT_EQ(ser.view().as_varints(0, std::span(xs)), ser.size());
+    EXPECT_EQ(xs, values);
+
+    auto ys = std::vector<std::int64_t>(values.size() + 1);
+    EXPECT_THROWN_MESSAGE(std::ignore = ser.view().as_varints(0, std::span(ys)), "Invalid varint");
+}
+
 TEST(DataView, InterpretAsBitPackedNumber_OneByte) {
     static constexpr auto data = std::to_array<unsigned char>({
         0b1100'0001
@@ -215,6 +410,20 @@ TEST(DataView, SubView_Length) {
     EXPECT_EQ(nova::data_view(data).subview(3, 1).size(), 1);
 }
 
+TEST(DataView, Checked) {
+    static constexpr auto data = std::to_array<unsigned char>({ 0x01, 0x02, 0x03, 0x04, 0x05 });
+    const auto record = nova::data_view_le(data).checked(1, 3);
+
+    static_assert(std::is_same_v<decltype(record), const nova::detail::data_view<nova::endian::little, false>>);
+    EXPECT_EQ(record.size(), 3);
+    EXPECT_EQ(record.as_number<std::uint16_t>(1), 0x0403);
+    EXPECT_ASSERTION_FAIL(std::ignore = record.as_number<std::uint16_t>(2));
+
+    EXPECT_EQ(nova::data_view(data).checked(5, 0).size(), 0);
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::data_view(data).checked(3, 3), "Out of bounds access: Pos=3 Len=3 End=6 \\(Size=5\\)");
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::data_view(data).checked(6, 0), "Out of bounds access: Pos=6 Len=0 End=6 \\(Size=5\\)");
+}
+
 TEST(DataView, ToHexString) {
     static constexpr auto data = "Hello Nova"sv;
     EXPECT_EQ(
@@ -223,6 +432,117 @@ TEST(DataView, ToHexString) {
     );
 }
 
+TEST(DataView, ToHexString_AllBytes) {
+    auto data = std::vector<std::byte>(256 + 17);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<std::byte>(i * 7);
+    }
+
+    std::string expected;
+    for (const auto b : data) {
+        expected += fmt::format("{:02x}", b);
+    }
+
+    // Every length, to cover both the vectorized part and the remainder.
+    for (std::size_t length = 0; length <= data.size(); length += 5) {
+        EXPECT_EQ(nova::data_view(data).as_hex_string(0, length), expected.substr(0, 2 * length));
+    }
+
+    auto buffer = std::string(2 * data.size(), '\0');
+    EXPECT_EQ(nova::data_view(data).format_hex(buffer.data()), buffer.data() + buffer.size());
+    EXPECT_EQ(buffer, expected);
+
+    auto appended = std::string{ "x" };
+    nova::data_view(data).format_hex(std::back_inserter(appended));
+    EXPECT_EQ(appended, fmt::format("x{}", expected));
+}
+
+TEST(DataView, FromHex) {
+    EXPECT_TRUE(nova::from_hex("").empty());
+    EXPECT_EQ(nova::data_view(nova::from_hex("00ff7F80aBcD")).as_hex_string(), "00ff7f80abcd");
+
+    const auto long_hex = std::string{ "0123456789abcdefABCDEF" } + std::string(2 * 300, 'e');
+    EXPECT_EQ(nova::data_view(nova::from_hex(long_hex)).as_hex_string(), "0123456789abcdefabcdef" + std::string(2 * 300, 'e'));
+}
+
+TEST(DataView, FromHex_Invalid) {
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::from_hex("abc"), "Invalid hex string: odd length 3");
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::from_hex("0g"), "Invalid hex string: unexpected character at 1");
+
+    // In a vectorized block
+    for (const auto ch : { '/', ':', '@', 'G', '`', 'g', ' ', '\x80', '\xFF' }) {
+        auto str = std::string(64, 'a');
+        str[37] = ch;
+        EXPECT_THROWN_MESSAGE(std::ignore = nova::from_hex(str), "Invalid hex string: unexpected character at 37");
+    }
+}
+
+TEST(DataView, FromHex_SerializerContext) {
+    auto ser = nova::serializer_context{ };
+    ser(std::uint8_t{ 1 });
+    nova::from_hex(std::string(2 * 600, 'a'), ser);
+    EXPECT_EQ(ser.size(), 601);
+    EXPECT_EQ(ser.view().as_hex_string(), "01" + std::string(2 * 600, 'a'));
+
+    auto str = std::string(2 * 600, 'a');
+    str[2 * 550] = 'x';
+    EXPECT_THROWN_MESSAGE(nova::from_hex(str, ser), "Invalid hex string: unexpected character at 1100");
+}
+
+TEST(DataView, FindByte) {
+    const auto data = std::string(100, 'a') + "b" + std::string(50, 'a') + "b";
+    const auto view = nova::data_view(data);
+
+    EXPECT_EQ(view.find(std::byte{ 'b' }), 100);
+    EXPECT_EQ(view.find(std::byte{ 'b' }, 100), 100);
+    EXPECT_EQ(view.find(std::byte{ 'b' }, 101), 151);
+    EXPECT_EQ(view.find(std::byte{ 'c' }), nova::data_view::npos);
+    EXPECT_EQ(view.find(std::byte{ 'a' }, 1000), nova::data_view::npos);
+}
+
+TEST(DataView, FindNeedle) {
+    auto data = std::string(200, 'a');
+    const auto view = nova::data_view(data);
+
+    // Every needle length and position, across the 16 byte blocks and the tail.
+    for (std::size_t length = 1; length <= 20; ++length) {
+        for (std::size_t pos = 0; pos + length <= data.size(); pos += 7) {
+            auto haystack = data;
+            const auto needle = std::string(length - 1, 'a') + 'b';
+            haystack.replace(pos, length, needle);
+
+            EXPECT_EQ(nova::data_view(haystack).find(nova::data_view(needle)), haystack.find(needle))
+                << "Length=" << length << " Pos=" << pos;
+        }
+    }
+
+    EXPECT_EQ(view.find(""_data), 0);
+    EXPECT_EQ(view.find(""_data, 200), 200);
+    EXPECT_EQ(view.find(""_data, 201), nova::data_view::npos);
+    EXPECT_EQ(view.find("ab"_data), nova::data_view::npos);
+    EXPECT_EQ("abc"_data.find("abcd"_data), nova::data_view::npos);
+
+    // First and last bytes match, the middle does not.
+    EXPECT_EQ("axb" "ayb" "azb"_data.find("azb"_data), 6);
+    EXPECT_EQ("\x00\x47\x1F\x00\x47\x1F"_data.find("\x47\x1F"_data, 2), 4);
+}
+
+TEST(DataView, FindFirstOf) {
+    const auto data = std::string(100, 'a') + "\r\n" + std::string(40, 'a') + "\n";
+    const auto view = nova::data_view(data);
+
+    EXPECT_EQ(view.find_first_of("\r\n"_data), 100);
+    EXPECT_EQ(view.find_first_of("\n\r"_data, 101), 101);
+    EXPECT_EQ(view.find_first_of("\r"_data, 101), nova::data_view::npos);
+    EXPECT_EQ(view.find_first_of("\r\n"_data, 102), 142);
+    EXPECT_EQ(view.find_first_of(""_data), nova::data_view::npos);
+    EXPECT_EQ(view.find_first_of("a"_data, 143), nova::data_view::npos);
+
+    // Larger sets are looked up in a table.
+    EXPECT_EQ(view.find_first_of("0123456789\n"_data), 101);
+    EXPECT_EQ(view.find_first_of("0123456789"_data), nova::data_view::npos);
+}
+
 TEST(DataView, ToVec) {
     static constexpr auto data = "\x00\x61"sv;
     EXPECT_EQ(
@@ -245,6 +565,13 @@ TEST(DataView, Formatter) {
 
     static const auto bin = "\x00\x01\x02"_data;
     EXPECT_EQ(fmt::format("{}", bin), "x000102");
+
+    static constexpr auto long_text = "Printable text longer than a SIMD register"sv;
+    EXPECT_EQ(fmt::format("{}", nova::data_view(long_text)), long_text);
+
+    auto mixed = std::string(long_text);
+    mixed[20] = '\x7F';
+    EXPECT_EQ(fmt::format("{}", nova::data_view(mixed)), fmt::format("x{}", nova::data_view(mixed).as_hex_string()));
 }
 
 TEST(DataView, ErrorOutOfBounds) {
@@ -302,6 +629,67 @@ TEST(Serialization, Serializer_8bytes_BigEndian) {
     EXPECT_EQ(nova::data_view{ ser.data() }.as_hex_string(), "01000000" "000000ff");
 }
 
+TEST(Serialization, Serializer_LittleEndian) {
+    auto ser = nova::serializer_context_le{ };
+    ser(std::uint8_t{ 9 });
+    ser(std::uint16_t{ 256 + 255 });
+    ser(std::uint32_t{ 16909060 });
+    ser(std::uint64_t{ 72057594037928191 });
+    EXPECT_EQ(
+        nova::data_view{ ser.data() }.as_hex_string(),
+        "09" "ff01" "04030201" "ff000000" "00000001"
+    );
+}
+
+TEST(Serialization, Serializer_Span_LittleEndian) {
+    const auto xs = std::to_array<std::uint16_t>({ 0x0102, 0x0304 });
+    auto ser = nova::serializer_context_le{ };
+    ser(xs);
+    EXPECT_EQ(nova::data_view{ ser.data() }.as_hex_string(), "0201" "0403");
+}
+
+TEST(Serialization, Serializer_Native) {
+    constexpr auto x = std::uint32_t{ 16909060 };
+    auto ser = nova::detail::serializer_context<nova::endian::native>{ };
+    ser(x);
+
+    auto expected = std::uint32_t{ };
+    const auto data = ser.data();
+    std::memcpy(&expected, data.data(), sizeof(expected));
+    EXPECT_EQ(expected, x);
+}
+
+TEST(Serialization, Serializer_FloatingPoint) {
+    auto ser = nova::serializer_context{ };
+    ser(1.5F);
+    ser(-3.141592653589793);
+    ser(std::bit_cast<float>(0x7FC0'1234U));
+    EXPECT_EQ(nova::data_view{ ser.data() }.as_hex_string(), "3fc00000" "c00921fb54442d18" "7fc01234");
+
+    auto ser_le = nova::serializer_context_le{ };
+    ser_le(1.5F);
+    ser_le(-0.0);
+    EXPECT_EQ(nova::data_view{ ser_le.data() }.as_hex_string(), "0000c03f" "0000000000000080");
+}
+
+TEST(Serialization, Serializer_FloatingPointRange) {
+    auto xs = std::vector<float>(37);
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = static_cast<float>(i) * 0.25F - 3.0F;
+    }
+    auto ser = nova::serializer_context{ };
+    ser(std::span<const float>(xs));
+
+    const auto view = ser.view();
+    ASSERT_EQ(view.size(), xs.size() * sizeof(float));
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        EXPECT_EQ(view.as_number<std::uint32_t>(i * sizeof(float)), std::bit_cast<std::uint32_t>(xs[i]));
+    }
+
+    static_assert(nova::serialized_size<std::array<double, 3>>() == 24);
+    static_assert(nova::detail::bitwise_serializable<std::array<float, 3>>());
+}
+
 TEST(Serialization, Serializer_String) {
     auto ser = nova::serializer_context{ };
     ser("abc"s);
@@ -314,6 +702,109 @@ TEST(Serialization, Serializer_StringView) {
     EXPECT_EQ(nova::data_view{ ser.data() }.as_hex_string(), "616263");
 }
 
+TEST(Serialization, Serializer_Span) {
+    const auto xs = std::to_array<std::uint16_t>({ 0x0102, 0x0304, 0x05FF });
+    auto ser = nova::serializer_context{ };
+    ser(std::span<const std::uint16_t>(xs));
+    EXPECT_EQ(nova::data_view{ ser.data() }.as_hex_string(), "0102" "0304" "05ff");
+}
+
+TEST(Serialization, Serializer_Vector) {
+    const auto xs = std::vector<std::uint32_t>{ 1, 16909060 };
+    auto ser = nova::serializer_context{ };
+    ser(std::uint8_t{ 9 });
+    ser(xs);
+    EXPECT_EQ(nova::data_view{ ser.data() }.as_hex_string(), "09" "02" "00000001" "01020304");
+}
+
+TEST(Serialization, Serializer_Array) {
+    const auto xs = std::to_array<std::uint64_t>({ 72057594037928191 });
+    const auto ys = std::to_array<std::uint8_t>({ 1, 2, 3 });
+    auto ser = nova::serializer_context{ };
+    ser(xs);
+    ser(ys);
+    EXPECT_EQ(nova::data_view{ ser.data() }.as_hex_string(), "01000000" "000000ff" "010203");
+}
+
+TEST(Serialization, Serializer_EmptyRange) {
+    auto ser = nova::serializer_context{ 0 };
+    ser(std::span<const std::uint32_t>{ });
+    EXPECT_TRUE(ser.data().empty());
+}
+
+TEST(Serialization, Serializer_ResetAndReuse) {
+    auto ser = nova::serializer_context{ 64 };
+    ser(std::uint32_t{ 0x01020304 });
+    EXPECT_EQ(ser.size(), 4);
+    const auto* buffer = ser.view().ptr();
+
+    ser.reset();
+    EXPECT_EQ(ser.size(), 0);
+    EXPECT_TRUE(ser.view().empty());
+
+    ser(std::uint16_t{ 0xABCD });
+    EXPECT_EQ(ser.view().ptr(), buffer);
+    EXPECT_EQ(ser.view().as_hex_string(), "abcd");
+    EXPECT_EQ(nova::data_view{ ser.data() }.as_hex_string(), "abcd");
+}
+
+TEST(Serialization, Serializer_View) {
+    auto ser = nova::serializer_context_le{ };
+    ser(std::uint16_t{ 0x0102 });
+    const auto view = ser.view();
+    static_assert(std::is_same_v<decltype(view), const nova::data_view_le>);
+    EXPECT_EQ(view.as_number<std::uint16_t>(0), 0x0102);
+    EXPECT_EQ(view.as_hex_string(), "0201");
+}
+
+TEST(Serialization, Serializer_Release) {
+    auto ser = nova::serializer_context{ 64 };
+    ser(std::uint16_t{ 0x0102 });
+    const auto* buffer = ser.view().ptr();
+
+    const auto data = ser.release();
+    EXPECT_EQ(data.data(), buffer);
+    EXPECT_EQ(nova::data_view{ data }.as_hex_string(), "0102");
+    EXPECT_EQ(ser.size(), 0);
+
+    ser(std::uint8_t{ 3 });
+    EXPECT_EQ(ser.view().as_hex_string(), "03");
+}
+
+TEST(Serialization, Serializer_Pmr) {
+    auto arena = std::array<std::byte, 256>{ };
+    auto resource = std::pmr::monotonic_buffer_resource{ arena.data(), arena.size(), std::pmr::null_memory_resource() };
+
+    auto ser = nova::pmr::serializer_context{ 16, &resource };
+    ser(std::uint64_t{ 1 });
+    ser(std::uint64_t{ 2 });
+    ser(std::string_view{ "ab" });
+    EXPECT_EQ(ser.view().as_hex_string(), "0000000000000001" "0000000000000002" "6162");
+
+    const auto data = ser.release();
+    EXPECT_GE(data.data(), arena.data());
+    EXPECT_LT(data.data(), arena.data() + arena.size());
+    EXPECT_EQ(data.get_allocator().resource(), &resource);
+}
+
+TEST(Serialization, Serializer_Varint) {
+    auto ser = nova::serializer_context{ };
+    ser(nova::varint{ std::uint32_t{ 0 } });
+    ser(nova::varint{ std::uint32_t{ 127 } });
+    ser(nova::varint{ std::uint32_t{ 300 } });
+    ser(nova::varint{ std::numeric_limits<std::uint64_t>::max() });
+    EXPECT_EQ(ser.view().as_hex_string(), "00" "7f" "ac02" "ffffffffffffffffff01");
+
+    ser.reset();
+    ser(nova::varint{ std::int32_t{ 0 } });
+    ser(nova::varint{ std::int32_t{ -1 } });
+    ser(nova::varint{ std::int32_t{ 1 } });
+    ser(nova::varint{ std::int8_t{ -64 } });
+    ser(nova::varint{ std::int8_t{ 64 } });
+    ser(nova::varint{ std::numeric_limits<std::int32_t>::min() });
+    EXPECT_EQ(ser.view().as_hex_string(), "00" "01" "02" "7f" "8001" "ffffffff0f");
+}
+
 struct data_t {
     std::uint64_t xl;
     std::string str;
@@ -350,11 +841,479 @@ TEST(Serialization, Serialize_FreeFunction) {
     );
 }
 
+struct header_t {
+    std::uint8_t type;
+    std::uint16_t length;
+    std::uint32_t sequence;
+};
+
+namespace nova {
+
+template <>
+struct serializer<header_t> {
+    template <endian Endianness>
+    void operator()(detail::serializer_context<Endianness>& ser, const header_t& x) {
+        ser(x.type);
+        ser(x.length);
+        ser(x.sequence);
+    }
+};
+
+template <>
+struct deserializer<header_t> {
+    template <typename Context>
+    void operator()(Context& deser, header_t& x) {
+        auto record = deser.take(7);
+        record(x.type);
+        record(x.length);
+        record(x.sequence);
+    }
+};
+
+} // namespace nova
+
+TEST(Deserialization, Deserializer_Numbers) {
+    static constexpr auto data = "\x09\x01\xff\x01\x02\x03\x04"sv;
+    auto deser = nova::deserializer_context{ nova::data_view(data) };
+
+    auto x8 = std::uint8_t{ };
+    auto x16 = std::uint16_t{ };
+    auto x32 = std::uint32_t{ };
+    deser(x8);
+    deser(x16);
+    EXPECT_EQ(deser.pos(), 3);
+    deser(x32);
+
+    EXPECT_EQ(x8, 9);
+    EXPECT_EQ(x16, 256 + 255);
+    EXPECT_EQ(x32, 16909060);
+    EXPECT_TRUE(deser.empty());
+}
+
+TEST(Deserialization, Deserializer_LittleEndian) {
+    static constexpr auto data = "\x01\xff"sv;
+    auto deser = nova::deserializer_context_le{ nova::data_view_le(data) };
+    auto x = std::uint16_t{ };
+    deser(x);
+    EXPECT_EQ(x, 0xFF01);
+}
+
+TEST(Deserialization, Deserializer_Range) {
+    static constexpr auto data = "\x01\x02\x03\x04\x05\x06\x07"sv;
+    auto deser = nova::deserializer_context{ nova::data_view(data) };
+
+    auto xs = std::vector<std::uint16_t>(2);
+    auto ys = std::array<std::uint8_t, 2>{ };
+    deser(std::span(xs));
+    deser(ys);
+
+    EXPECT_THAT(xs, testing::ElementsAre(0x0102, 0x0304));
+    EXPECT_THAT(ys, testing::ElementsAre(0x05, 0x06));
+    EXPECT_EQ(deser.remaining(), 1);
+}
+
+TEST(Deserialization, Deserializer_Varint) {
+    static constexpr auto data = "\xAC\x02\x03\x01"sv;
+
+    auto length = nova::varint<std::uint16_t>{ };
+    auto delta = nova::varint<std::int8_t>{ };
+    auto x = std::uint8_t{ };
+
+    auto deser = nova::deserializer_context{ nova::data_view(data) };
+    deser(length);
+    deser(delta);
+    deser(x);
+    EXPECT_EQ(length.value, 300);
+    EXPECT_EQ(delta.value, -2);
+    EXPECT_EQ(x, 1);
+    EXPECT_TRUE(deser.empty());
+}
+
+TEST(Deserialization, Deserializer_Skip) {
+    static constexpr auto data = "\x01\x02\x03"sv;
+    auto deser = nova::deserializer_context{ nova::data_view(data) };
+    auto x = std::uint8_t{ };
+    deser.skip(2);
+    deser(x);
+    EXPECT_EQ(x, 3);
+}
+
+TEST(Deserialization, Deserializer_Custom) {
+    const auto header = header_t{ 1, 2, 3 };
+    const auto data = nova::serialize(header);
+    const auto result = nova::deserialize<header_t>(nova::data_view(data));
+
+    EXPECT_EQ(result.type, header.type);
+    EXPECT_EQ(result.length, header.length);
+    EXPECT_EQ(result.sequence, header.sequence);
+}
+
+TEST(Deserialization, ErrorOutOfBounds) {
+    static constexpr auto data = "\x01\x02\x03"sv;
+
+    EXPECT_THAT(
+        []{ std::ignore = nova::deserialize<header_t>(nova::data_view(data)); },
+        testing::ThrowsMessage<nova::exception>(
+            testing::HasSubstr("Out of bounds access: Pos=0 Len=7 End=7 (Size=3)")
+        )
+    );
+
+    auto deser = nova::deserializer_context{ nova::data_view(data) };
+    auto xs = std::vector<std::uint16_t>(2);
+    EXPECT_THROWN_MESSAGE(deser(std::span(xs)), "Out of bounds access: Pos=0 Len=4 End=4 \\(Size=3\\)");
+}
+
+TEST(Deserialization, TakeIsNotBoundChecked) {
+    static constexpr auto data = "\x01\x02\x03"sv;
+    auto deser = nova::deserializer_context{ nova::data_view(data) };
+    auto record = deser.take(2);
+    auto x = std::uint32_t{ };
+
+    static_assert(std::is_same_v<decltype(record), nova::detail::deserializer_context<nova::endian::big, false>>);
+    EXPECT_EQ(deser.pos(), 2);
+    EXPECT_ASSERTION_FAIL(record(x));
+}
+
+struct record_t {
+    std::uint8_t type;
+    std::uint32_t value;
+    std::uint16_t flags;
+};
+
+struct nested_t {
+    record_t record;
+    std::array<std::uint16_t, 2> xs;
+};
+
+struct named_t {
+    std::uint8_t id;
+    std::string name;
+};
+
+#pragma pack(push, 1)
+struct packed_t {
+    std::uint32_t x;
+    std::uint16_t y;
+    std::uint8_t z;
+};
+#pragma pack(pop)
+
+struct sized_t {
+    std::uint32_t x;
+};
+
+namespace nova {
+
+template <>
+struct serializer<sized_t> {
+    static constexpr std::size_t size = 2;
+
+    template <endian Endianness>
+    void operator()(detail::serializer_context<Endianness>& ser, const sized_t& x) {
+        ser(static_cast<std::uint16_t>(x.x));
+    }
+};
+
+} // namespace nova
+
+/**
+ * Same size as its object representation, but serialized differently.
+ */
+struct inverted_t {
+    std::uint16_t x;
+};
+
+struct with_inverted_t {
+    inverted_t inverted;
+    std::uint16_t y;
+};
+
+namespace nova {
+
+template <>
+struct serializer<inverted_t> {
+    static constexpr std::size_t size = 2;
+
+    template <endian Endianness>
+    void operator()(detail::serializer_context<Endianness>& ser, const inverted_t& x) {
+        ser(static_cast<std::uint16_t>(~x.x));
+    }
+};
+
+template <>
+struct deserializer<inverted_t> {
+    template <typename Context>
+    void operator()(Context& deser, inverted_t& x) {
+        deser(x.x);
+        x.x = static_cast<std::uint16_t>(~x.x);
+    }
+};
+
+} // namespace nova
+
+TEST(Serialization, SerializedSize) {
+    static_assert(nova::serialized_size<std::uint16_t>() == 2);
+    static_assert(nova::serialized_size<std::array<std::uint32_t, 3>>() == 12);
+    static_assert(nova::serialized_size<record_t>() == 7);
+    static_assert(nova::serialized_size<nested_t>() == 11);
+    static_assert(nova::serialized_size<packed_t>() == 7);
+    static_assert(nova::serialized_size<sized_t>() == 2);
+
+    static_assert(not nova::fixed_size_serializable<std::string>);
+    static_assert(not nova::fixed_size_serializable<named_t>);
+    static_assert(not nova::fixed_size_serializable<header_t>);
+}
+
+TEST(Serialization, Aggregate) {
+    const auto x = nested_t{ { 1, 2, 3 }, { 4, 5 } };
+    EXPECT_EQ(
+        nova::data_view(nova::serialize(x)).as_hex_string(),
+        "01" "00000002" "0003" "0004" "0005"
+    );
+    EXPECT_EQ(
+        nova::data_view(nova::serialize<nova::endian::little>(x)).as_hex_string(),
+        "01" "02000000" "0300" "0400" "0500"
+    );
+}
+
+TEST(Serialization, Aggregate_DynamicSize) {
+    const auto x = named_t{ 1, "abc" };
+    EXPECT_EQ(nova::data_view(nova::serialize(x)).as_hex_string(), "01" "03" "616263");
+}
+
+TEST(Serialization, Aggregate_Packed) {
+    static_assert(nova::detail::bitwise_serializable<packed_t>());
+    static_assert(not nova::detail::bitwise_serializable<record_t>());
+
+    const auto x = packed_t{ 1, 2, 3 };
+    const auto data = nova::serialize<nova::endian::native>(x);
+    ASSERT_EQ(data.size(), sizeof(packed_t));
+    EXPECT_EQ(std::memcmp(data.data(), &x, sizeof(packed_t)), 0);
+
+    EXPECT_EQ(nova::data_view(nova::serialize(x)).as_hex_string(), "00000001" "0002" "03");
+}
+
+TEST(Serialization, Aggregate_CustomMember) {
+    static_assert(not nova::detail::bitwise_serializable<inverted_t>());
+    static_assert(not nova::detail::bitwise_serializable<with_inverted_t>());
+
+    const auto x = with_inverted_t{ { 0x0102 }, 0x0304 };
+    const auto data = nova::serialize<nova::endian::little>(x);
+    EXPECT_EQ(nova::data_view(data).as_hex_string(), "fdfe" "0403");
+
+    const auto result = nova::deserialize<with_inverted_t>(nova::detail::data_view<nova::endian::little>(data));
+    EXPECT_EQ(result.inverted.x, 0x0102);
+    EXPECT_EQ(result.y, 0x0304);
+}
+
+TEST(Deserialization, Aggregate) {
+    const auto x = nested_t{ { 1, 2, 3 }, { 4, 5 } };
+    const auto data = nova::serialize(x);
+    const auto result = nova::deserialize<nested_t>(nova::data_view(data));
+
+    EXPECT_EQ(result.record.type, 1);
+    EXPECT_EQ(result.record.value, 2);
+    EXPECT_EQ(result.record.flags, 3);
+    EXPECT_THAT(result.xs, testing::ElementsAre(4, 5));
+}
+
+TEST(Deserialization, Aggregate_DynamicSize) {
+    struct message_t {
+        std::uint8_t id;
+        std::vector<std::uint32_t> xs;
+        std::string name;
+    };
+
+    const auto x = message_t{ 7, { 1, 2, 3 }, "ab" };
+    const auto data = nova::serialize(x);
+    EXPECT_EQ(nova::data_view(data).as_hex_string(), "07" "03" "00000001" "00000002" "00000003" "02" "6162");
+
+    const auto result = nova::deserialize<message_t>(nova::data_view(data));
+    EXPECT_EQ(result.id, 7);
+    EXPECT_THAT(result.xs, testing::ElementsAre(1, 2, 3));
+    EXPECT_EQ(result.name, "ab");
+}
+
+TEST(Deserialization, Aggregate_Packed) {
+    const auto x = packed_t{ 1, 2, 3 };
+    const auto data = nova::serialize<nova::endian::native>(x);
+    const auto result = nova::deserialize<packed_t>(nova::detail::data_view<nova::endian::native>(data));
+
+    EXPECT_EQ(result.x, 1);
+    EXPECT_EQ(result.y, 2);
+    EXPECT_EQ(result.z, 3);
+}
+
+TEST(Deserialization, Aggregate_BoundCheckedOnce) {
+    static constexpr auto data = "\x01\x02\x03"sv;
+
+    EXPECT_THAT(
+        []{ std::ignore = nova::deserialize<record_t>(nova::data_view(data)); },
+        testing::ThrowsMessage<nova::exception>(
+            testing::HasSubstr("Out of bounds access: Pos=0 Len=7 End=7 (Size=3)")
+        )
+    );
+}
+
+TEST(Serialization, Containers_SerializedSize) {
+    static_assert(nova::serialized_size<std::array<record_t, 2>>() == 14);
+    static_assert(nova::serialized_size<std::tuple<std::uint8_t, record_t>>() == 8);
+    static_assert(nova::serialized_size<std::pair<std::uint16_t, std::array<std::uint8_t, 3>>>() == 5);
+    static_assert(nova::detail::bitwise_serializable<std::array<packed_t, 2>>());
+
+    static_assert(not nova::fixed_size_serializable<std::vector<record_t>>);
+    static_assert(not nova::fixed_size_serializable<std::optional<std::uint8_t>>);
+    static_assert(not nova::fixed_size_serializable<std::tuple<std::uint8_t, std::string>>);
+}
+
+TEST(Serialization, Vector) {
+    const auto xs = std::vector<record_t>{ { 1, 2, 3 }, { 4, 5, 6 } };
+    EXPECT_EQ(
+        nova::data_view(nova::serialize(xs)).as_hex_string(),
+        "02" "01" "00000002" "0003" "04" "00000005" "0006"
+    );
+    EXPECT_EQ(nova::data_view(nova::serialize(std::vector<record_t>{ })).as_hex_string(), "00");
+}
+
+TEST(Serialization, Vector_LengthPrefixedElements) {
+    const auto xs = std::vector<std::string>{ "ab", "", "c" };
+    EXPECT_EQ(nova::data_view(nova::serialize(xs)).as_hex_string(), "03" "026162" "00" "0163");
+
+    const auto ys = std::vector<std::vector<std::uint16_t>>{ { 1, 2 }, { 3 } };
+    EXPECT_EQ(nova::data_view(nova::serialize(ys)).as_hex_string(), "02" "02" "0001" "0002" "01" "0003");
+}
+
+TEST(Serialization, Optional) {
+    EXPECT_EQ(nova::data_view(nova::serialize(std::optional<std::uint16_t>{ 258 })).as_hex_string(), "01" "0102");
+    EXPECT_EQ(nova::data_view(nova::serialize(std::optional<std::uint16_t>{ })).as_hex_string(), "00");
+    EXPECT_EQ(nova::data_view(nova::serialize(std::optional<std::string>{ "ab" })).as_hex_string(), "01" "02" "6162");
+}
+
+TEST(Serialization, Variant) {
+    using variant_t = std::variant<std::uint8_t, std::string, record_t>;
+    EXPECT_EQ(nova::data_view(nova::serialize(variant_t{ std::uint8_t{ 7 } })).as_hex_string(), "00" "07");
+    EXPECT_EQ(nova::data_view(nova::serialize(variant_t{ "ab" })).as_hex_string(), "01" "02" "6162");
+    EXPECT_EQ(nova::data_view(nova::serialize(variant_t{ record_t{ 1, 2, 3 } })).as_hex_string(), "02" "01" "00000002" "0003");
+}
+
+TEST(Serialization, TupleAndPair) {
+    const auto x = std::tuple<std::uint8_t, std::string, std::uint16_t>{ 1, "ab", 2 };
+    EXPECT_EQ(nova::data_view(nova::serialize(x)).as_hex_string(), "01" "02" "6162" "0002");
+    EXPECT_EQ(nova::data_view(nova::serialize(std::pair<std::uint8_t, std::uint32_t>{ 1, 2 })).as_hex_string(), "01" "00000002");
+}
+
+TEST(Serialization, FlatMap) {
+    const auto x = nova::flat_map<std::uint16_t, std::string>{ { 1, "a" }, { 2, "b" } };
+    EXPECT_EQ(nova::data_view(nova::serialize(x)).as_hex_string(), "02" "0001" "0002" "0161" "0162");
+}
+
+TEST(Deserialization, Containers_RoundTrip) {
+    struct message_t {
+        std::uint8_t type;
+        std::vector<record_t> records;
+        std::optional<std::string> comment;
+        std::array<std::pair<std::uint8_t, std::uint16_t>, 2> pairs;
+        std::variant<std::uint32_t, std::vector<std::string>> tags;
+        nova::flat_map<std::uint32_t, std::vector<std::uint16_t>> series;
+    };
+
+    const auto x = message_t{
+        .type = 5,
+        .records = { { 1, 2, 3 }, { 4, 5, 6 } },
+        .comment = "nova",
+        .pairs = { { { 1, 2 }, { 3, 4 } } },
+        .tags = std::vector<std::string>{ "a", "bc" },
+        .series = { { 10, { 1, 2, 3 } }, { 20, { } } },
+    };
+    const auto data = nova::serialize(x);
+    auto deser = nova::deserializer_context{ nova::data_view(data) };
+    auto result = message_t{ };
+    deser(result);
+
+    EXPECT_TRUE(deser.empty());
+    EXPECT_EQ(result.type, 5);
+    ASSERT_EQ(result.records.size(), 2);
+    EXPECT_EQ(result.records[1].type, 4);
+    EXPECT_EQ(result.records[1].value, 5);
+    EXPECT_EQ(result.records[1].flags, 6);
+    EXPECT_EQ(result.comment, "nova");
+    EXPECT_EQ(result.pairs, x.pairs);
+    EXPECT_EQ(result.tags, x.tags);
+    EXPECT_EQ(result.series.keys(), x.series.keys());
+    EXPECT_EQ(result.series.values(), x.series.values());
+}
+
+TEST(Deserialization, FloatingPoint) {
+    struct sample_t {
+        std::uint32_t id;
+        double value;
+        std::array<float, 3> samples;
+    };
+
+    static_assert(nova::serialized_size<sample_t>() == 4 + 8 + 3 * 4);
+
+    const auto x = sample_t{ 1, -2.5, { 0.5F, std::numeric_limits<float>::infinity(), -0.0F } };
+
+    const auto result = nova::deserialize<sample_t>(nova::data_view(nova::serialize(x)));
+    EXPECT_EQ(result.id, 1);
+    EXPECT_EQ(result.value, -2.5);
+    EXPECT_EQ(result.samples[0], 0.5F);
+    EXPECT_EQ(result.samples[1], std::numeric_limits<float>::infinity());
+    EXPECT_TRUE(std::signbit(result.samples[2]));
+
+    const auto ys = std::optional<std::vector<float>>{ { 1.0F, 2.0F } };
+    EXPECT_EQ(nova::deserialize<std::optional<std::vector<float>>>(nova::data_view(nova::serialize(ys))), ys);
+}
+
+TEST(Deserialization, Containers_BitwiseNative) {
+    const auto xs = std::vector<packed_t>{ { 1, 2, 3 }, { 4, 5, 6 } };
+    const auto data = nova::serialize<nova::endian::native>(xs);
+    ASSERT_EQ(data.size(), 1 + 2 * sizeof(packed_t));
+
+    const auto result = nova::deserialize<std::vector<packed_t>>(nova::detail::data_view<nova::endian::native>(data));
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_EQ(result[1].x, 4);
+    EXPECT_EQ(result[1].y, 5);
+    EXPECT_EQ(result[1].z, 6);
+}
+
+TEST(Deserialization, Containers_Invalid) {
+    EXPECT_THROWN_MESSAGE(
+        std::ignore = nova::deserialize<std::vector<record_t>>("\x03\x01\x00\x00\x00\x02\x00\x03"_data),
+        "Out of bounds access: Pos=1 Len=21 End=22 \\(Size=8\\)"
+    );
+    EXPECT_THROWN_MESSAGE(
+        std::ignore = nova::deserialize<std::vector<record_t>>("\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x7F"_data),
+        "Out of bounds access: Pos=9 Len=1 End=10 \\(Size=9\\)"
+    );
+    EXPECT_THROWN_MESSAGE(
+        std::ignore = nova::deserialize<std::vector<std::string>>("\x01\x05" "abc"_data),
+        "Out of bounds access: Pos=2 Len=5 End=7 \\(Size=5\\)"
+    );
+    EXPECT_THROWN_MESSAGE(
+        std::ignore = nova::deserialize<std::optional<std::uint8_t>>("\x02\x01"_data),
+        "Invalid optional flag 2: Pos=0 Len=1 End=1 \\(Size=2\\)"
+    );
+    EXPECT_THROWN_MESSAGE(
+        (std::ignore = nova::deserialize<std::variant<std::uint8_t, std::uint16_t>>("\x02\x01"_data)),
+        "Invalid variant index 2: Pos=0 Len=1 End=1 \\(Size=2\\)"
+    );
+    EXPECT_THROWN_MESSAGE(
+        (std::ignore = nova::deserialize<nova::flat_map<std::uint8_t, std::uint8_t>>("\x02\x02\x01\x00\x00"_data)),
+        "Invalid map: keys are not sorted or not unique: Pos=0 Len=3 End=3 \\(Size=5\\)"
+    );
+}
+
 TEST(Data, Identity_DataView_Serialization_BigEndian) {
     constexpr auto x = std::uint16_t{ 333 };
     EXPECT_EQ(nova::data_view_be{ nova::serialize(x) }.as_number<std::uint16_t>(0), x);
 }
 
+TEST(Data, Identity_DataView_Serialization_LittleEndian) {
+    constexpr auto x = std::uint32_t{ 333'333 };
+    EXPECT_EQ(nova::data_view_le{ nova::serialize<nova::endian::little>(x) }.as_number<std::uint32_t>(0), x);
+}
+
 TEST(Data, StreamBuffer_LimitedSize) {
     EXPECT_THROWN_MESSAGE(
         nova::stream_buffer{ static_cast<nova::stream_buffer<>::difference_type>(std::numeric_limits<int>::max()) + 1 },
@@ -417,3 +1376,96 @@ TEST(Data, StreamBuffer_ResizingBuffer) {
     EXPECT_EQ(buf.size(), buf.view().size());
     EXPECT_EQ(buf.view().as_string(), data);
 }
+
+#ifdef NOVA_LINUX
+
+TEST(Data, StreamBuffer_FillFrom) {
+    const auto data = std::string(60'000, 'a') + "end";
+    auto fds = pipe_fds{ O_NONBLOCK };
+    ASSERT_EQ(::write(fds.write, data.data(), data.size()), data.size());
+
+    // The free space is grown from 128 bytes before reading.
+    auto buf = nova::stream_buffer{ 100'000 };
+    const auto result = buf.fill_from(fds.read);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->bytes, data.size());
+    EXPECT_EQ(result->status, nova::io_status::ok);
+    EXPECT_EQ(buf.view().as_string(), data);
+
+    const auto would_block = buf.fill_from(fds.read);
+    ASSERT_TRUE(would_block.has_value());
+    EXPECT_EQ(would_block->bytes, 0);
+    EXPECT_EQ(would_block->status, nova::io_status::would_block);
+
+    fds.close_write();
+    const auto eof = buf.fill_from(fds.read);
+    ASSERT_TRUE(eof.has_value());
+    EXPECT_EQ(eof->status, nova::io_status::eof);
+}
+
+TEST(Data, StreamBuffer_FillFrom_LimitedSize) {
+    auto fds = pipe_fds{ O_NONBLOCK };
+    ASSERT_EQ(::write(fds.write, "Hello Nova", 10), 10);
+
+    auto buf = nova::stream_buffer{ 6 };
+    EXPECT_EQ(buf.fill_from(fds.read)->bytes, 6);
+    EXPECT_EQ(buf.fill_from(fds.read)->bytes, 0);
+    EXPECT_EQ(buf.view().as_string(), "Hello ");
+
+    buf.consume(6);
+    EXPECT_EQ(buf.fill_from(fds.read)->bytes, 4);
+    EXPECT_EQ(buf.view().as_string(), "Nova");
+}
+
+TEST(Data, StreamBuffer_DrainTo) {
+    auto fds = pipe_fds{ O_NONBLOCK };
+    const auto data = std::string(200'000, 'a');
+
+    auto buf = nova::stream_buffer{ 300'000 };
+    ASSERT_EQ(buf.write(nova::data_view(data)), data.size());
+
+    // The pipe fills up before the buffer is drained.
+    const auto result = buf.drain_to(fds.write);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->status, nova::io_status::would_block);
+    EXPECT_GT(result->bytes, 0);
+    EXPECT_EQ(buf.size(), data.size() - result->bytes);
+
+    auto received = nova::stream_buffer{ 300'000 };
+    while (not buf.empty() or not received.empty()) {
+        ASSERT_TRUE(received.fill_from(fds.read).has_value());
+        received.consume();
+        ASSERT_TRUE(buf.drain_to(fds.write).has_value());
+    }
+}
+
+TEST(Data, StreamBuffer_SocketPair) {
+    auto fds = std::array<int, 2>{ };
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds.data()), 0);
+
+    auto out = nova::stream_buffer{ 1024 };
+    auto in = nova::stream_buffer{ 1024 };
+    EXPECT_EQ(out.write("Hello Nova"_data), 10);
+
+    EXPECT_EQ(out.drain_to(fds[0])->bytes, 10);
+    EXPECT_TRUE(out.empty());
+    EXPECT_EQ(in.fill_from(fds[1])->bytes, 10);
+    EXPECT_EQ(in.view().as_string(), "Hello Nova");
+
+    close(fds[0]);
+    EXPECT_EQ(in.fill_from(fds[1])->status, nova::io_status::eof);
+    close(fds[1]);
+}
+
+TEST(Data, StreamBuffer_InvalidFileDescriptor) {
+    auto buf = nova::stream_buffer{ 10 };
+    EXPECT_EQ(buf.write("a"_data), 1);
+
+    const auto read = buf.fill_from(-1);
+    ASSERT_FALSE(read.has_value());
+    EXPECT_THAT(read.error().message, testing::HasSubstr("Cannot read from file descriptor -1"));
+    EXPECT_FALSE(buf.drain_to(-1).has_value());
+    EXPECT_EQ(buf.size(), 1);
+}
+
+#endif // NOVA_LINUX
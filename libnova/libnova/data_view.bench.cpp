@@ -0,0 +1,461 @@
+#include <libnova/bit_fields.hpp>
+#include <libnova/checksum.hpp>
+#include <libnova/data.hpp>
+#include <libnova/float_packing.hpp>
+#include <libnova/integer_packing.hpp>
+#include <libnova/random.hpp>
+#include <libnova/record_view.hpp>
+#include <libnova/types.hpp>
+#include <libnova/units.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+auto random_bytes(std::size_t size) -> std::vector<std::uint8_t> {
+    auto& rng = nova::random();
+    auto ret = std::vector<std::uint8_t>(size);
+    for (auto& x : ret) {
+        x = rng.number(nova::range<std::uint8_t>{ 0, 255 });
+    }
+    return ret;
+}
+
+/**
+ * Varints of values with up to `max_bits` bits.
+ */
+auto random_varints(std::size_t length, std::uint8_t max_bits) -> nova::bytes {
+    auto& rng = nova::random();
+    auto ser = nova::serializer_context{ length };
+    for (std::size_t i = 0; i < length; ++i) {
+        const auto bits = rng.number(nova::range<std::uint8_t>{ 1, max_bits });
+        ser(nova::varint{ rng.number(nova::range<std::uint64_t>{ 0, std::numeric_limits<std::uint64_t>::max() >> (64 - bits) }) });
+    }
+    return ser.release();
+}
+
+} // namespace
+
+template <typename T>
+static void per_byte_loop(benchmark::State& state) {
+    const auto length = static_cast<std::size_t>(state.range(0));
+    const auto data = random_bytes(length * sizeof(T));
+    const auto view = nova::data_view(data);
+    auto out = std::vector<T>(length);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < length; ++i) {
+            out[i] = view.as_number<T>(i * sizeof(T), sizeof(T));
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+template <typename T>
+static void single_value(benchmark::State& state) {
+    const auto length = static_cast<std::size_t>(state.range(0));
+    const auto data = random_bytes(length * sizeof(T));
+    const auto view = nova::data_view(data);
+    auto out = std::vector<T>(length);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < length; ++i) {
+            out[i] = view.as_number<T>(i * sizeof(T));
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+template <typename T>
+static void bulk(benchmark::State& state) {
+    const auto length = static_cast<std::size_t>(state.range(0));
+    const auto data = random_bytes(length * sizeof(T));
+    const auto view = nova::data_view(data);
+    auto out = std::vector<T>(length);
+
+    for (auto _ : state) {
+        view.as_numbers(0, std::span(out));
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+template <std::uint8_t MaxBits>
+static void varint_single(benchmark::State& state) {
+    const auto length = static_cast<std::size_t>(state.range(0));
+    const auto data = random_varints(length, MaxBits);
+    const auto view = nova::data_view(data);
+    auto out = std::vector<std::uint64_t>(length);
+
+    for (auto _ : state) {
+        std::size_t pos = 0;
+        for (std::size_t i = 0; i < length; ++i) {
+            const auto [value, size] = view.as_varint(pos);
+            out[i] = value;
+            pos += size;
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+template <std::uint8_t MaxBits>
+static void varint_bulk(benchmark::State& state) {
+    const auto length = static_cast<std::size_t>(state.range(0));
+    const auto data = random_varints(length, MaxBits);
+    const auto view = nova::data_view(data);
+    auto out = std::vector<std::uint64_t>(length);
+
+    for (auto _ : state) {
+        std::ignore = view.as_varints(0, std::span(out));
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+static void hex_encode(benchmark::State& state) {
+    const auto length = static_cast<std::size_t>(state.range(0));
+    const auto data = random_bytes(length);
+    const auto view = nova::data_view(data);
+
+    for (auto _ : state) {
+        auto hex = view.as_hex_string();
+        benchmark::DoNotOptimize(hex);
+    }
+}
+
+static void hex_decode(benchmark::State& state) {
+    const auto length = static_cast<std::size_t>(state.range(0));
+    const auto hex = nova::data_view(random_bytes(length)).as_hex_string();
+
+    for (auto _ : state) {
+        auto data = nova::from_hex(hex);
+        benchmark::DoNotOptimize(data);
+    }
+}
+
+/**
+ * Searching a sync marker at the end of random data, which has no 0xFF bytes.
+ */
+static void find_needle(benchmark::State& state) {
+    auto data = random_bytes(static_cast<std::size_t>(state.range(0)));
+    std::ranges::replace(data, 0xFF, 0xFE);
+    data[data.size() - 2] = 0xFF;
+    data[data.size() - 1] = 0x47;
+    const auto view = nova::data_view(data);
+    const auto needle = nova::data_view("\xFF\x47", 2);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view.find(needle));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void find_needle_std_search(benchmark::State& state) {
+    auto data = random_bytes(static_cast<std::size_t>(state.range(0)));
+    std::ranges::replace(data, 0xFF, 0xFE);
+    data[data.size() - 2] = 0xFF;
+    data[data.size() - 1] = 0x47;
+    const auto needle = std::to_array<std::uint8_t>({ 0xFF, 0x47 });
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::search(data.begin(), data.end(), needle.begin(), needle.end()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void find_first_of(benchmark::State& state) {
+    auto data = random_bytes(static_cast<std::size_t>(state.range(0)));
+    std::ranges::replace(data, '\r', 'a');
+    std::ranges::replace(data, '\n', 'a');
+    data.back() = '\n';
+    const auto view = nova::data_view(data);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view.find_first_of(nova::data_view("\r\n", 2)));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void crc32c_portable(benchmark::State& state) {
+    const auto data = random_bytes(static_cast<std::size_t>(state.range(0)));
+    const auto view = nova::data_view(data);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(nova::detail::crc32c_portable(0, view.ptr(), view.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void crc32c(benchmark::State& state) {
+    const auto data = random_bytes(static_cast<std::size_t>(state.range(0)));
+    const auto view = nova::data_view(data);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(nova::crc32c(view));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+using trade = nova::record_layout<
+    nova::field<"id",       std::uint32_t, 0>,
+    nova::field<"price",    std::uint64_t, 4>,
+    nova::field<"quantity", std::uint32_t, 12>
+>;
+
+/**
+ * Sums the fields of consecutive 16 byte records with `as_number()` at
+ * magic offsets.
+ */
+static void records_as_number(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto data = random_bytes(count * trade::size);
+    const auto view = nova::data_view(data);
+
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto pos = i * trade::size;
+            sum += view.as_number<std::uint32_t>(pos) + view.as_number<std::uint64_t>(pos + 4) + view.as_number<std::uint32_t>(pos + 12);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void records_overlay(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto data = random_bytes(count * trade::size);
+    const auto view = nova::data_view(data);
+
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (const auto& x : nova::as_records<trade>(view, 0, count)) {
+            sum += x.get<"id">() + x.get<"price">() + x.get<"quantity">();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Same as `records_as_number`, but the bounds are checked once per record.
+ */
+static void records_checked_region(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto data = random_bytes(count * trade::size);
+    const auto view = nova::data_view(data);
+
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto record = view.checked(i * trade::size, trade::size);
+            sum += record.as_number<std::uint32_t>(0) + record.as_number<std::uint64_t>(4) + record.as_number<std::uint32_t>(12);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using namespace nova::units::literals;
+
+constexpr auto packed_header = nova::bit_field_plan{
+    nova::bit_field{ "version", nova::extent{ 0_bit, 4_bit } },
+    nova::bit_field{ "flags",   nova::extent{ 4_bit, 12_bit } },
+    nova::bit_field{ "length",  nova::extent{ 2_byte, 2_byte } },
+    nova::bit_field{ "id",      nova::extent{ 35_bit, 29_bit } },
+};
+
+/**
+ * Decodes the bit fields of consecutive 8 byte records one by one.
+ */
+static void bit_fields_per_record(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto data = random_bytes(count * packed_header.record_size());
+    const auto view = nova::data_view(data);
+    auto columns = std::array<std::vector<std::uint64_t>, 4>{ };
+    for (auto& x : columns) {
+        x.resize(count);
+    }
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto pos = nova::units::bytes{ static_cast<long long>(i * packed_header.record_size()) };
+            columns[0][i] = view.as_number<std::uint64_t>(nova::extent{ pos, 4_bit });
+            columns[1][i] = view.as_number<std::uint64_t>(nova::extent{ pos + 4_bit, 12_bit });
+            columns[2][i] = view.as_number<std::uint64_t>(nova::extent{ pos + 2_byte, 2_byte });
+            columns[3][i] = view.as_number<std::uint64_t>(nova::extent{ pos + 35_bit, 29_bit });
+        }
+        benchmark::DoNotOptimize(columns);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void bit_fields_plan(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto data = random_bytes(count * packed_header.record_size());
+    const auto view = nova::data_view(data);
+    auto storage = std::array<std::vector<std::uint64_t>, 4>{ };
+    auto columns = std::array<std::span<std::uint64_t>, 4>{ };
+    for (std::size_t f = 0; f < storage.size(); ++f) {
+        storage[f].resize(count);
+        columns[f] = storage[f];
+    }
+
+    for (auto _ : state) {
+        packed_header.decode(view, 0, count, packed_header.record_size(), columns);
+        benchmark::DoNotOptimize(storage);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Timestamps in microseconds at roughly regular intervals.
+ */
+static auto timestamps(std::size_t count) -> std::vector<std::uint64_t> {
+    auto& rng = nova::random();
+    auto ret = std::vector<std::uint64_t>(count);
+    auto x = std::uint64_t{ 1'700'000'000'000'000 };
+    for (auto& t : ret) {
+        x += 1'000 + rng.number(nova::range<std::uint64_t>{ 0, 50 });
+        t = x;
+    }
+    return ret;
+}
+
+static void timestamps_raw(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto ser = nova::detail::serializer_context<>{ };
+    const auto xs = timestamps(count);
+    ser(std::span(xs));
+    const auto data = ser.data();
+    const auto view = nova::data_view(data);
+    auto out = std::vector<std::uint64_t>(count);
+
+    for (auto _ : state) {
+        view.as_numbers(0, std::span(out));
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes"] = static_cast<double>(data.size());
+}
+
+static void timestamps_packed(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto ser = nova::detail::serializer_context<>{ };
+    nova::pack_integers(ser, timestamps(count));
+    const auto data = ser.data();
+    const auto view = nova::data_view(data);
+    auto out = std::vector<std::uint64_t>(count);
+
+    for (auto _ : state) {
+        std::ignore = nova::unpack_integers(view, 0, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes"] = static_cast<double>(data.size());
+}
+
+/**
+ * Slowly changing gauge samples with repeats.
+ */
+static auto gauges(std::size_t count) -> std::vector<double> {
+    auto ret = std::vector<double>(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        ret[i] = std::round(std::sin(static_cast<double>(i / 4) / 50.0) * 1000.0) / 8.0;
+    }
+    return ret;
+}
+
+static void gauges_raw(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto ser = nova::detail::serializer_context<>{ };
+    const auto xs = gauges(count);
+    ser(std::span(xs));
+    const auto data = ser.data();
+    const auto view = nova::data_view(data);
+    auto out = std::vector<double>(count);
+
+    for (auto _ : state) {
+        view.as_numbers(0, std::span(out));
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes"] = static_cast<double>(data.size());
+}
+
+static void gauges_packed(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto ser = nova::detail::serializer_context<>{ };
+    nova::pack_floats(ser, gauges(count));
+    const auto data = ser.data();
+    const auto view = nova::data_view(data);
+    auto out = std::vector<double>(count);
+
+    for (auto _ : state) {
+        std::ignore = nova::unpack_floats(view, 0, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes"] = static_cast<double>(data.size());
+}
+
+BENCHMARK(per_byte_loop<std::uint16_t>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(per_byte_loop<std::uint32_t>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(per_byte_loop<std::uint64_t>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(single_value<std::uint16_t>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(single_value<std::uint32_t>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(single_value<std::uint64_t>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(bulk<std::uint16_t>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(bulk<std::uint32_t>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(bulk<std::uint64_t>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(single_value<float>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(single_value<double>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(bulk<float>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(bulk<double>)->RangeMultiplier(8)->Range(64, 2 << 16);
+
+BENCHMARK(varint_single<7>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(varint_single<14>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(varint_single<64>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(varint_bulk<7>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(varint_bulk<14>)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(varint_bulk<64>)->RangeMultiplier(8)->Range(64, 2 << 16);
+
+BENCHMARK(hex_encode)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(hex_decode)->RangeMultiplier(8)->Range(64, 2 << 16);
+
+BENCHMARK(find_needle)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(find_needle_std_search)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(find_first_of)->RangeMultiplier(8)->Range(64, 2 << 16);
+
+BENCHMARK(crc32c_portable)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(crc32c)->RangeMultiplier(8)->Range(64, 2 << 16);
+
+BENCHMARK(records_as_number)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(records_checked_region)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(records_overlay)->RangeMultiplier(8)->Range(64, 2 << 16);
+
+BENCHMARK(bit_fields_per_record)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(bit_fields_plan)->RangeMultiplier(8)->Range(64, 2 << 16);
+
+BENCHMARK(timestamps_raw)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(timestamps_packed)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(gauges_raw)->RangeMultiplier(8)->Range(64, 2 << 16);
+BENCHMARK(gauges_packed)->RangeMultiplier(8)->Range(64, 2 << 16);
+
+BENCHMARK_MAIN();
@@ -132,6 +132,16 @@ private:
 
 } // namespace detail
 
+/**
+ * @brief   Tag for constructing a `flat_map` from keys that are already sorted
+ *          and unique.
+ */
+struct sorted_unique_t {
+    explicit sorted_unique_t() = default;
+};
+
+inline constexpr auto sorted_unique = sorted_unique_t{ };
+
 template <typename Key,
           typename T,
           typename Compare = std::less<Key>,
@@ -185,6 +195,16 @@ public:
         range_initialize(std::begin(ilist), std::end(ilist));
     }
 
+    /**
+     * @brief   Take over the containers of keys and their associated values.
+     *
+     * The keys must be sorted and unique, and there must be a value for each.
+     */
+    constexpr flat_map(sorted_unique_t /* tag */, key_container_type keys, mapped_container_type values)
+        : m_keys(std::move(keys))
+        , m_values(std::move(values))
+    {}
+
     [[nodiscard]] constexpr bool empty()                          const noexcept { return m_keys.empty(); }
     [[nodiscard]] constexpr size_type size()                      const noexcept { return m_keys.size(); }
     [[nodiscard]] constexpr const key_container_type& keys()      const noexcept { return m_keys; }
@@ -22,6 +22,13 @@ TEST(FlatMap, ConstructFromInitializerList) {
     EXPECT_EQ(map.keys(), ( std::vector{ 2, 3 } ));
 }
 
+TEST(FlatMap, ConstructFromSortedContainers) {
+    const auto map = IntMap(nova::sorted_unique, { 2, 3 }, { 4, 6 });
+
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.at(3), 6);
+}
+
 TEST(FlatMap, Observers) {
     auto map = IntMap();
 
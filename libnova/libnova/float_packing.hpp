@@ -0,0 +1,307 @@
+/**
+ * Part of Nova C++ Library.
+ *
+ * Compact encoding of floating point series, e.g., gauges of metrics.
+ *
+ * Every value is XOR-ed with the previous one, as in Facebook's Gorilla: equal
+ * values take a single bit, and values close to each other share the sign,
+ * the exponent and the top of the mantissa, so only the meaningful bits of
+ * the difference are written, between its leading and trailing zeros:
+ *
+ * - `0`: same value as the previous one
+ * - `10` + bits: the meaningful bits fit into the previous window
+ * - `11` + 5 bits of leading zeros + 6 bits of length - 1 + bits: new window
+ *
+ * The series is split into blocks that start over from a raw value, and every
+ * block has a length prefix, so blocks can be located at once and decoded in
+ * parallel:
+ *
+ * ```cpp
+ * auto ser = nova::detail::serializer_context<>{ };
+ * nova::pack_floats(ser, gauges);
+ *
+ * const auto xs = nova::unpack_floats<double>(ser.view());
+ *
+ * // Split between threads
+ * auto blocks = std::vector<nova::packed_float_block>{ };
+ * std::ignore = nova::packed_float_blocks<double>(ser.view(), 0, blocks);
+ * auto ys = std::vector<double>(blocks.empty() ? 0 : blocks.back().first + blocks.back().count);
+ * for (const auto& x : blocks) {
+ *     pool.post([&ys, x] { nova::unpack_float_block(x, std::span(ys).subspan(x.first, x.count)); });
+ * }
+ * ```
+ *
+ * Format:
+ *
+ * - varint: number of values
+ * - if there is any:
+ *   - varint: number of values per block
+ *   - 1 byte: size of a value, 4 or 8
+ *   - every block: varint byte length, then the bits (MSB first, padded to
+ *     a byte boundary) with the first value raw
+ */
+
+#pragma once
+
+#include <libnova/bit_stream.hpp>
+#include <libnova/data.hpp>
+#include <libnova/error.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace nova {
+
+namespace detail {
+
+    inline constexpr std::size_t DefaultFloatBlockSize = 1024;
+
+    /**
+     * @brief   Write the values XOR-ed with their predecessor.
+     */
+    template <ieee_floating_point T, typename Writer>
+    void xor_encode_block(Writer& writer, const T* src, std::size_t count) {
+        using U = byteswap_type_t<T>;
+        static constexpr std::size_t Bits = sizeof(T) * 8;
+        static constexpr std::size_t MaxLeading = 31;
+
+        auto prev = std::bit_cast<U>(*src);
+        writer.write(prev, Bits);
+
+        // The window of the meaningful bits; none at first
+        std::size_t leading = 0;
+        std::size_t length = 0;
+
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        for (std::size_t i = 1; i < count; ++i) {
+            const auto x = std::bit_cast<U>(src[i]);
+            const auto diff = static_cast<U>(x ^ prev);
+            prev = x;
+
+            if (diff == 0) {
+                writer.write(0, 1);
+                continue;
+            }
+
+            const auto lz = std::min(static_cast<std::size_t>(std::countl_zero(diff)), MaxLeading);
+            const auto tz = static_cast<std::size_t>(std::countr_zero(diff));
+
+            if (length > 0 and lz >= leading and tz >= Bits - leading - length) {
+                writer.write(0b10, 2);
+                writer.write(diff >> (Bits - leading - length), length);
+            }
+            else {
+                leading = lz;
+                length = Bits - lz - tz;
+                writer.write(0b11U << 11U | leading << 6U | (length - 1), 13);
+                writer.write(diff >> tz, length);
+            }
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * @brief   Read `out.size()` values written by `xor_encode_block()`.
+     *
+     * @throws  if the bits are truncated or invalid.
+     */
+    template <ieee_floating_point T, bool B>
+    void xor_decode_block(bit_reader<bit_order::msb_first, B>& reader, std::span<T> out) {
+        using U = byteswap_type_t<T>;
+        static constexpr std::size_t Bits = sizeof(T) * 8;
+
+        if (out.empty()) {
+            return;
+        }
+
+        auto prev = reader.template read<U>(Bits);
+        out[0] = std::bit_cast<T>(prev);
+
+        std::size_t leading = 0;
+        std::size_t length = 0;
+
+        for (std::size_t i = 1; i < out.size(); ++i) {
+            if (reader.read(1) != 0) {
+                if (reader.read(1) != 0) {
+                    const auto header = reader.read(11);
+                    leading = header >> 6U;
+                    length = (header & 0x3FU) + 1;
+                    if (leading + length > Bits) {
+                        throw exception(
+                            "Invalid packed float window of {} bits after {} leading zeros: {} (bits)",
+                            length, leading, data_cursor{ reader.pos() - 13, 13, reader.size() }
+                        );
+                    }
+                }
+                else if (length == 0) {
+                    throw exception("Invalid packed float: no window to reuse: {} (bits)", data_cursor{ reader.pos() - 2, 2, reader.size() });
+                }
+                prev ^= static_cast<U>(reader.read(length) << (Bits - leading - length));
+            }
+            out[i] = std::bit_cast<T>(prev);
+        }
+    }
+
+} // namespace detail
+
+/**
+ * @brief   A block of a packed floating point series, see `packed_float_blocks()`.
+ */
+struct packed_float_block {
+    data_view data;
+
+    /**
+     * Index of the first value of the block in the series.
+     */
+    std::size_t first = 0;
+    std::size_t count = 0;
+};
+
+/**
+ * @brief   Write a series of floating point numbers XOR encoded, in blocks of
+ *          `block_size` values.
+ *
+ * Read it back with `unpack_floats()` into the same type.
+ *
+ * @throws  if `block_size` is 0.
+ */
+template <endian Endianness, typename Allocator, std::ranges::contiguous_range Range>
+    requires ieee_floating_point<std::ranges::range_value_t<Range>>
+void pack_floats(
+    detail::serializer_context<Endianness, Allocator>& ser,
+    const Range& xs,
+    std::size_t block_size = detail::DefaultFloatBlockSize
+) {
+    using T = std::ranges::range_value_t<Range>;
+    if (block_size == 0) {
+        throw exception("Invalid packed float block size 0");
+    }
+
+    const auto n = std::ranges::size(xs);
+    ser(varint{ n });
+    if (n == 0) {
+        return;
+    }
+    ser(varint{ block_size });
+    ser(static_cast<std::uint8_t>(sizeof(T)));
+
+    auto writer = bit_writer<>{ std::min(n, block_size) * sizeof(T) };
+    for (std::size_t first = 0; first < n; first += block_size) {
+        writer.reset();
+        detail::xor_encode_block(writer, std::next(std::ranges::data(xs), static_cast<std::ptrdiff_t>(first)), std::min(block_size, n - first));
+        writer.finish();
+
+        const auto block = writer.context().view();
+        ser(varint{ block.size() });
+        ser(block);
+    }
+}
+
+/**
+ * @brief   Locate the blocks of a series written by `pack_floats()` from `pos`,
+ *          replacing the content of `blocks`.
+ *
+ * The blocks point into `data`, and they can be decoded independently with
+ * `unpack_float_block()`.
+ *
+ * @returns the number of bytes of the series.
+ * @throws  if the data is truncated or invalid, or it is not a series of `T`.
+ */
+template <ieee_floating_point T, endian E, bool B>
+auto packed_float_blocks(const detail::data_view<E, B>& data, std::size_t pos, std::vector<packed_float_block>& blocks) -> std::size_t {
+    const auto begin = pos;
+    const auto [n, n_size] = data.template as_varint<std::size_t>(pos);
+    pos += n_size;
+
+    blocks.clear();
+    if (n == 0) {
+        return pos - begin;
+    }
+
+    const auto [block_size, block_size_size] = data.template as_varint<std::size_t>(pos);
+    if (block_size == 0) {
+        throw exception("Invalid packed float block size 0: {}", detail::data_cursor{ pos, block_size_size, data.size() });
+    }
+    pos += block_size_size;
+
+    const auto value_size = std::size_t{ data.template as_number<std::uint8_t>(pos) };
+    if (value_size != sizeof(T)) {
+        throw exception("Invalid packed float value size {}, expected {}: {}", value_size, sizeof(T), detail::data_cursor{ pos, 1, data.size() });
+    }
+    pos += 1;
+
+    // Every value takes at least a bit, and every block at least a byte
+    const auto count = n / block_size + (n % block_size != 0 ? 1 : 0);
+    if (n > 8 * (data.size() - pos) or count > data.size() - pos) {
+        throw exception("Invalid packed float count {}: {}", n, detail::data_cursor{ begin, n_size, data.size() });
+    }
+
+    blocks.reserve(count);
+    for (std::size_t first = 0; first < n; first += block_size) {
+        const auto [size, size_size] = data.template as_varint<std::size_t>(pos);
+        pos += size_size;
+
+        const auto block = data.checked(pos, size);
+        const auto values = std::min(block_size, n - first);
+        if (values > 8 * size) {
+            throw exception("Invalid packed float block of {} values: {}", values, detail::data_cursor{ pos, size, data.size() });
+        }
+        blocks.push_back({ data_view{ block.ptr(), block.size() }, first, values });
+        pos += size;
+    }
+
+    return pos - begin;
+}
+
+/**
+ * @brief   Decode a block of a packed series into `out` of `block.count` values.
+ *
+ * @throws  if the block is truncated or invalid.
+ */
+template <ieee_floating_point T>
+void unpack_float_block(const packed_float_block& block, std::span<T> out) {
+    nova_assert(out.size() == block.count);
+
+    auto reader = bit_reader{ block.data };
+    detail::xor_decode_block(reader, out);
+}
+
+/**
+ * @brief   Read a series of floating point numbers written by `pack_floats()`
+ *          from `pos` into `out`, replacing its content.
+ *
+ * @returns the number of bytes read.
+ * @throws  if the data is truncated or invalid, or it is not a series of `T`.
+ */
+template <ieee_floating_point T, endian E, bool B>
+auto unpack_floats(const detail::data_view<E, B>& data, std::size_t pos, std::vector<T>& out) -> std::size_t {
+    auto blocks = std::vector<packed_float_block>{ };
+    const auto size = packed_float_blocks<T>(data, pos, blocks);
+
+    out.resize(blocks.empty() ? 0 : blocks.back().first + blocks.back().count);
+    for (const auto& x : blocks) {
+        unpack_float_block(x, std::span(out).subspan(x.first, x.count));
+    }
+    return size;
+}
+
+/**
+ * @brief   Read a series of floating point numbers written by `pack_floats()`
+ *          from `pos`.
+ *
+ * @throws  if the data is truncated or invalid, or it is not a series of `T`.
+ */
+template <ieee_floating_point T, endian E, bool B>
+[[nodiscard]] auto unpack_floats(const detail::data_view<E, B>& data, std::size_t pos = 0) -> std::vector<T> {
+    auto ret = std::vector<T>{ };
+    std::ignore = unpack_floats(data, pos, ret);
+    return ret;
+}
+
+} // namespace nova
@@ -0,0 +1,148 @@
+#define NOVA_RUNTIME_ASSERTIONS
+
+#include <libnova/data.hpp>
+#include <libnova/float_packing.hpp>
+#include <libnova/test_utils.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+template <typename T>
+auto gauge_series(std::size_t size) -> std::vector<T> {
+    auto ret = std::vector<T>(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        // Slowly changing with repeats, like a sampled gauge
+        ret[i] = static_cast<T>(std::round(std::sin(static_cast<double>(i / 4) / 50.0) * 1000.0) / 8.0);
+    }
+    return ret;
+}
+
+/**
+ * @brief   Compare the bits, so that NaNs and signed zeros count too.
+ */
+template <typename T>
+auto same_bits(const std::vector<T>& xs, const std::vector<T>& ys) -> bool {
+    return std::ranges::equal(xs, ys, [](T x, T y) { return std::bit_cast<nova::detail::byteswap_type_t<T>>(x) == std::bit_cast<nova::detail::byteswap_type_t<T>>(y); });
+}
+
+} // namespace
+
+template <typename T>
+class FloatPacking : public testing::Test { };
+
+using FloatPackingTypes = testing::Types<float, double>;
+TYPED_TEST_SUITE(FloatPacking, FloatPackingTypes);
+
+TYPED_TEST(FloatPacking, RoundTrip) {
+    using T = TypeParam;
+    using limits = std::numeric_limits<T>;
+
+    for (const auto size : { 0U, 1U, 2U, 1023U, 1024U, 1025U, 5000U }) {
+        const auto xs = gauge_series<T>(size);
+        auto ser = nova::detail::serializer_context<>{ };
+        nova::pack_floats(ser, xs);
+        EXPECT_TRUE(same_bits(nova::unpack_floats<T>(ser.view()), xs)) << "Size=" << size;
+    }
+
+    const auto specials = std::vector<T>{
+        0, -0.0, 1, 1, limits::quiet_NaN(), limits::infinity(), -limits::infinity(), limits::denorm_min(),
+        limits::max(), limits::lowest(), limits::epsilon(), 1, -limits::quiet_NaN(), 0,
+    };
+    for (const auto block_size : { 1U, 3U, 1024U }) {
+        auto ser = nova::detail::serializer_context<>{ };
+        nova::pack_floats(ser, specials, block_size);
+        EXPECT_TRUE(same_bits(nova::unpack_floats<T>(ser.view()), specials)) << "Block size=" << block_size;
+    }
+}
+
+TEST(FloatPacking, Format) {
+    auto ser = nova::detail::serializer_context<>{ };
+
+    // 1.0, 1.0: raw, then a single 0 bit
+    // 1.5: XOR 0x0008'0000'0000'0000 -> 12 leading zeros, 1 bit: 11 01100 000000 1
+    nova::pack_floats(ser, std::vector<double>{ 1.0, 1.0, 1.5 });
+    EXPECT_EQ(ser.view().as_hex_string(), "03" "8008" "08" "0a" "3ff0000000000000" "6c02");
+}
+
+TEST(FloatPacking, RegularSeriesIsCompact) {
+    const auto xs = gauge_series<double>(10'000);
+
+    auto ser = nova::detail::serializer_context<>{ };
+    nova::pack_floats(ser, xs);
+    EXPECT_LT(ser.size(), xs.size() * sizeof(double) / 4);
+    EXPECT_EQ(nova::unpack_floats<double>(ser.view()), xs);
+}
+
+TEST(FloatPacking, ParallelBlocks) {
+    const auto xs = gauge_series<double>(5000);
+
+    auto ser = nova::detail::serializer_context<nova::endian::little>{ };
+    ser(std::uint8_t{ 0xAB });
+    nova::pack_floats(ser, xs, 1000);
+    ser(std::uint8_t{ 0xCD });
+
+    auto blocks = std::vector<nova::packed_float_block>{ };
+    const auto size = nova::packed_float_blocks<double>(ser.view(), 1, blocks);
+    EXPECT_EQ(ser.view().as_number<std::uint8_t>(1 + size), 0xCD);
+    ASSERT_EQ(blocks.size(), 5);
+    EXPECT_EQ(blocks[4].first, 4000);
+    EXPECT_EQ(blocks[4].count, 1000);
+
+    auto ys = std::vector<double>(xs.size());
+    {
+        auto threads = std::vector<std::jthread>{ };
+        for (const auto& x : blocks) {
+            threads.emplace_back([&ys, x] { nova::unpack_float_block(x, std::span(ys).subspan(x.first, x.count)); });
+        }
+    }
+    EXPECT_EQ(ys, xs);
+}
+
+TEST(FloatPacking, InvalidData) {
+    auto ser = nova::detail::serializer_context<>{ };
+    nova::pack_floats(ser, std::vector<double>{ 1.0, 1.0, 1.5 });
+    const auto data = ser.data();
+
+    const auto truncated = nova::data_view(data).subview(0, data.size() - 1);
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::unpack_floats<double>(truncated), "Out of bounds access");
+
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::unpack_floats<float>(nova::data_view(data)), "Invalid packed float value size 8, expected 4: Pos=3 Len=1");
+
+    // Window of 64 bits after 12 leading zeros: 0 11 01100 | 111111
+    auto wide = data;
+    wide[14] = std::byte{ 0b1111'1100 };
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::unpack_floats<double>(nova::data_view(wide)), "Invalid packed float window of 64 bits after 12 leading zeros");
+
+    // Reuse of the window without any: 0 10
+    auto reuse = data;
+    reuse[13] = std::byte{ 0b0101'0000 };
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::unpack_floats<double>(nova::data_view(reuse)), "Invalid packed float: no window to reuse");
+
+    const auto too_many = nova::from_hex("ff01" "01" "08" "00");
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::unpack_floats<double>(nova::data_view(too_many)), "Invalid packed float count 255");
+
+    // 2^34 values in a single block of 2 bytes
+    const auto huge = nova::from_hex("8080808040" "8080808040" "08" "01" "00");
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::unpack_floats<double>(nova::data_view(huge)), "Invalid packed float count 17179869184");
+
+    // 20 values in a block of 1 byte
+    const auto short_block = nova::from_hex("14" "14" "08" "01" "00" "0000");
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::unpack_floats<double>(nova::data_view(short_block)), "Invalid packed float block of 20 values: Pos=4 Len=1");
+}
+
+TEST(FloatPacking, InvalidBlockSize) {
+    auto ser = nova::detail::serializer_context<>{ };
+    EXPECT_THROWN_MESSAGE(nova::pack_floats(ser, std::vector<double>{ 1.0 }, 0), "Invalid packed float block size 0");
+}
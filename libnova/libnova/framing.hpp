@@ -0,0 +1,352 @@
+/**
+ * Part of Nova C++ Library.
+ *
+ * Message framing over byte streams.
+ *
+ * A frame is a fixed size header followed by a payload, whose length is
+ * either a fixed width integer in the header, or a varint directly after it.
+ * Frames are sliced out of the unread data of a buffer without copying, and
+ * consumed in batch:
+ *
+ * ```cpp
+ * // 2 bytes of type, 4 bytes of big endian payload length
+ * constexpr auto format = nova::frame_format{
+ *     .header_size = 6,
+ *     .length_field = { 2, 4 },
+ * };
+ *
+ * auto buf = nova::stream_buffer{ 1024 * 1024 };
+ * std::ignore = buf.fill_from(socket);
+ *
+ * nova::consume_frames(buf, format, [](const nova::frame& frame) {
+ *     handle(frame.header.as_number<std::uint16_t>(0), frame.payload);
+ * });
+ * ```
+ *
+ * Works with every buffer having `view()` and `consume(n)` where `view()` is
+ * all the unread data. Buffers that also have `segments()`, like
+ * `segmented_buffer`, are supported too: frames spanning segments are copied
+ * together. A `spsc_ring_buffer` has to be mirrored.
+ */
+
+#pragma once
+
+#include <libnova/data.hpp>
+#include <libnova/error.hpp>
+#include <libnova/types.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <vector>
+
+namespace nova {
+
+/**
+ * @brief   Describes how frames are delimited.
+ */
+struct frame_format {
+    /**
+     * Size of the fixed header in bytes, including a fixed width length field.
+     */
+    std::size_t header_size = 0;
+
+    /**
+     * Position and length of the payload length in the header, in bytes.
+     * Ignored if `varint_length` is set.
+     */
+    extent<std::size_t> length_field = { 0, 0 };
+
+    endian length_endianness = endian::big;
+
+    /**
+     * The payload length is a varint directly after the fixed header.
+     */
+    bool varint_length = false;
+
+    /**
+     * The length field counts the header as well, not only the payload.
+     */
+    bool length_includes_header = false;
+
+    /**
+     * Frames larger than this (header included) are rejected.
+     */
+    std::size_t max_frame_size = std::numeric_limits<std::size_t>::max();
+};
+
+/**
+ * @brief   A complete frame pointing into the buffer it is parsed from.
+ */
+struct frame {
+    data_view header;
+    data_view payload;
+
+    [[nodiscard]] auto size() const -> std::size_t { return header.size() + payload.size(); }
+};
+
+/**
+ * @brief   Slices complete frames out of a view one by one.
+ *
+ * ```cpp
+ * auto parser = nova::frame_parser{ buf.view(), format };
+ * while (auto frame = parser.next()) {
+ *     ...
+ * }
+ * buf.consume(parser.consumed());
+ * ```
+ */
+class frame_parser {
+public:
+    [[nodiscard]] frame_parser(data_view data, const frame_format& format)
+        : m_data(data)
+        , m_format(format)
+    {
+        nova_assert(format.varint_length or format.length_field.len <= sizeof(std::uint64_t));
+        nova_assert(format.varint_length or format.length_field.pos + format.length_field.len <= format.header_size);
+    }
+
+    /**
+     * @brief   The next complete frame, if there is one.
+     *
+     * @throws  if the frame is larger than the maximum size, its length is
+     *          smaller than the header, or the varint length is invalid.
+     */
+    [[nodiscard]] auto next() -> std::optional<frame> {
+        const auto bounds = next_bounds();
+        if (not bounds.has_value() or m_data.size() - m_consumed < bounds->size) {
+            return std::nullopt;
+        }
+
+        const auto pos = m_consumed;
+        m_consumed += bounds->size;
+        return frame{
+            m_data.subview(pos, m_format.header_size),
+            m_data.subview(pos + bounds->header_size, bounds->size - bounds->header_size),
+        };
+    }
+
+    /**
+     * @brief   Size of the next frame if its header is complete, even if the
+     *          frame itself is not.
+     *
+     * @throws  same as `next()`.
+     */
+    [[nodiscard]] auto next_size() const -> std::optional<std::size_t> {
+        const auto bounds = next_bounds();
+        return bounds.has_value() ? std::optional(bounds->size) : std::nullopt;
+    }
+
+    /**
+     * @brief   Number of bytes of the frames returned so far.
+     */
+    [[nodiscard]] auto consumed() const -> std::size_t { return m_consumed; }
+
+private:
+    data_view m_data;
+    frame_format m_format;
+    std::size_t m_consumed = 0;
+
+    struct frame_bounds {
+        /**
+         * The fixed header and the varint length, if any.
+         */
+        std::size_t header_size;
+        std::size_t size;
+    };
+
+    [[nodiscard]] auto next_bounds() const -> std::optional<frame_bounds> {
+        const auto available = m_data.size() - m_consumed;
+        if (available < m_format.header_size) {
+            return std::nullopt;
+        }
+
+        const auto pos = m_consumed;
+        auto header_size = m_format.header_size;
+        auto length = std::size_t{ };
+
+        if (m_format.varint_length) {
+            const auto [value, size] = detail::load_varint<std::uint64_t>(
+                std::next(m_data.ptr(), static_cast<std::ptrdiff_t>(pos + header_size)),
+                available - header_size
+            );
+            if (size == 0) {
+                if (truncated_varint(pos + header_size)) {
+                    return std::nullopt;
+                }
+                throw exception("Invalid frame length: {}", detail::data_cursor{ pos + header_size, 0, m_data.size() });
+            }
+            length = value;
+            header_size += size;
+        }
+        else {
+            length = read_length(pos + m_format.length_field.pos);
+        }
+
+        return frame_bounds{ header_size, frame_size_check(pos, header_size, length) };
+    }
+
+    [[nodiscard]] auto read_length(std::size_t pos) const -> std::size_t {
+        const auto length = m_format.length_field.len;
+        if (m_format.length_endianness == endian::big) {
+            return data_view_be(m_data.span()).as_number<std::size_t>(pos, length);
+        }
+        return data_view_le(m_data.span()).as_number<std::size_t>(pos, length);
+    }
+
+    /**
+     * @brief   Whether the varint at `pos` continues beyond the available data.
+     */
+    [[nodiscard]] auto truncated_varint(std::size_t pos) const -> bool {
+        const auto rest = m_data.subview(pos);
+        return rest.size() < detail::MaxVarintSize<std::uint64_t>
+            and std::ranges::all_of(rest, [](std::byte x) { return std::to_integer<std::uint8_t>(x) >= 0x80; });
+    }
+
+    /**
+     * @returns the size of the whole frame.
+     */
+    [[nodiscard]] auto frame_size_check(std::size_t pos, std::size_t header_size, std::size_t length) const -> std::size_t {
+        if (m_format.length_includes_header) {
+            if (length < header_size) {
+                throw exception(
+                    "Invalid frame length {} with header size {}: {}",
+                    length, header_size, detail::data_cursor{ pos, header_size, m_data.size() }
+                );
+            }
+            length -= header_size;
+        }
+
+        if (length > m_format.max_frame_size or header_size > m_format.max_frame_size - length) {
+            throw exception(
+                "Frame size is over the limit {}: {}",
+                m_format.max_frame_size, detail::data_cursor{ pos, header_size, m_data.size() }
+            );
+        }
+        return header_size + length;
+    }
+};
+
+namespace detail {
+
+    /**
+     * @brief   Buffers exposing all their unread data as `segments()`.
+     */
+    template <typename Buffer>
+    concept segmented_frame_source = requires (const Buffer& buf) {
+        requires std::ranges::input_range<decltype(buf.segments())>;
+        requires std::convertible_to<std::ranges::range_value_t<decltype(buf.segments())>, nova::data_view>;
+    };
+
+    template <typename Buffer, typename Callable>
+    auto consume_view_frames(Buffer& buf, const frame_format& format, Callable& func) -> std::size_t {
+        auto parser = frame_parser{ buf.view(), format };
+        std::size_t count = 0;
+
+        try {
+            while (const auto x = parser.next()) {
+                std::invoke(func, *x);
+                ++count;
+            }
+        }
+        catch (...) {
+            buf.consume(parser.consumed());
+            throw;
+        }
+
+        buf.consume(parser.consumed());
+        return count;
+    }
+
+    /**
+     * @brief   Copy the first `n` unread bytes of the buffer into `out`.
+     */
+    template <segmented_frame_source Buffer>
+    void gather_front(const Buffer& buf, std::size_t n, std::vector<std::byte>& out) {
+        out.clear();
+        for (const nova::data_view segment : buf.segments()) {
+            if (out.size() == n) {
+                break;
+            }
+            const auto length = std::min(segment.size(), n - out.size());
+            out.insert(out.end(), segment.ptr(), std::next(segment.ptr(), static_cast<std::ptrdiff_t>(length)));
+        }
+    }
+
+    /**
+     * @brief   Copy the frame at the front of the buffer together if it is
+     *          complete, but not within `view()`, then pass it to `func`.
+     *
+     * @returns whether a frame was consumed.
+     */
+    template <segmented_frame_source Buffer, typename Callable>
+    auto consume_spanning_frame(Buffer& buf, const frame_format& format, Callable& func, std::vector<std::byte>& scratch) -> bool {
+        const auto available = static_cast<std::size_t>(buf.size());
+        if (buf.view().size() == available) {
+            return false;
+        }
+
+        gather_front(buf, std::min(available, format.header_size + MaxVarintSize<std::uint64_t>), scratch);
+        const auto size = frame_parser{ nova::data_view{ scratch }, format }.next_size();
+        if (not size.has_value() or *size > available) {
+            return false;
+        }
+
+        gather_front(buf, *size, scratch);
+        auto parser = frame_parser{ nova::data_view{ scratch }, format };
+        try {
+            std::invoke(func, *parser.next());
+        }
+        catch (...) {
+            buf.consume(*size);
+            throw;
+        }
+        buf.consume(*size);
+        return true;
+    }
+
+} // namespace detail
+
+/**
+ * @brief   Call `func` with every complete frame in the unread data of the
+ *          buffer, then consume them at once.
+ *
+ * Frames point into the buffer, so they are valid only during the call.
+ * Frames spanning the segments of a segmented buffer are copied together
+ * first. An incomplete frame at the end is left in the buffer.
+ *
+ * @returns the number of frames consumed.
+ * @throws  if a frame is invalid or `func` throws; the frames already passed
+ *          to `func` are consumed. Also if the buffer is a ring buffer
+ *          without mirrored memory, whose `view()` ends at the wrap around.
+ */
+template <typename Buffer, typename Callable>
+auto consume_frames(Buffer& buf, const frame_format& format, Callable&& func) -> std::size_t {
+    if constexpr (requires { { buf.mirrored() } -> std::convertible_to<bool>; }) {
+        if (not buf.mirrored()) {
+            throw exception("Frames cannot be parsed from a ring buffer without mirrored memory");
+        }
+    }
+
+    if constexpr (detail::segmented_frame_source<Buffer>) {
+        auto scratch = std::vector<std::byte>{ };
+        std::size_t count = 0;
+        while (true) {
+            count += detail::consume_view_frames(buf, format, func);
+            if (not detail::consume_spanning_frame(buf, format, func, scratch)) {
+                return count;
+            }
+            ++count;
+        }
+    }
+    else {
+        return detail::consume_view_frames(buf, format, func);
+    }
+}
+
+} // namespace nova
@@ -0,0 +1,189 @@
+#define NOVA_RUNTIME_ASSERTIONS
+
+#include <libnova/data.hpp>
+#include <libnova/framing.hpp>
+#include <libnova/ring_buffer.hpp>
+#include <libnova/segmented_buffer.hpp>
+#include <libnova/test_utils.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace nova::literals;
+
+namespace {
+
+// 1 byte of type, 2 bytes of big endian payload length
+constexpr auto Format = nova::frame_format{
+    .header_size = 3,
+    .length_field = { 1, 2 },
+};
+
+auto collect(auto& buf, const nova::frame_format& format) -> std::vector<std::string> {
+    std::vector<std::string> ret;
+    nova::consume_frames(buf, format, [&ret](const nova::frame& x) {
+        ret.emplace_back(x.payload.as_string());
+    });
+    return ret;
+}
+
+} // namespace
+
+TEST(FrameParser, FixedLength) {
+    const auto data = "\x01\x00\x05Hello" "\x02\x00\x00" "\x03\x00\x04Nova" "\x04\x00"_data;
+    auto parser = nova::frame_parser{ data, Format };
+
+    auto x = parser.next();
+    ASSERT_TRUE(x.has_value());
+    EXPECT_EQ(x->header.as_number<std::uint8_t>(0), 1);
+    EXPECT_EQ(x->payload.as_string(), "Hello");
+    EXPECT_EQ(x->size(), 8);
+    EXPECT_EQ(x->payload.ptr(), data.ptr() + 3);
+
+    x = parser.next();
+    ASSERT_TRUE(x.has_value());
+    EXPECT_TRUE(x->payload.empty());
+
+    x = parser.next();
+    ASSERT_TRUE(x.has_value());
+    EXPECT_EQ(x->payload.as_string(), "Nova");
+
+    EXPECT_FALSE(parser.next().has_value());
+    EXPECT_EQ(parser.consumed(), 18);
+}
+
+TEST(FrameParser, LittleEndianLengthIncludesHeader) {
+    constexpr auto format = nova::frame_format{
+        .header_size = 4,
+        .length_field = { 0, 4 },
+        .length_endianness = nova::endian::little,
+        .length_includes_header = true,
+    };
+    const auto data = "\x06\x00\x00\x00" "ab" "\x04\x00\x00\x00"_data;
+    auto parser = nova::frame_parser{ data, format };
+
+    EXPECT_EQ(parser.next()->payload.as_string(), "ab");
+    EXPECT_TRUE(parser.next()->payload.empty());
+    EXPECT_FALSE(parser.next().has_value());
+
+    const auto invalid = "\x03\x00\x00\x00"_data;
+    EXPECT_THROWN_MESSAGE(
+        std::ignore = nova::frame_parser(invalid, format).next(),
+        "Invalid frame length 3 with header size 4"
+    );
+}
+
+TEST(FrameParser, VarintLength) {
+    constexpr auto format = nova::frame_format{
+        .header_size = 1,
+        .varint_length = true,
+    };
+    const auto payload = std::string(300, 'x');
+    const auto data = std::string("\x07\x03" "abc" "\x08\xAC\x02") + payload + "\x09\x80";
+    auto parser = nova::frame_parser{ nova::data_view(data), format };
+
+    auto x = parser.next();
+    ASSERT_TRUE(x.has_value());
+    EXPECT_EQ(x->header.as_string(), "\x07");
+    EXPECT_EQ(x->payload.as_string(), "abc");
+
+    x = parser.next();
+    ASSERT_TRUE(x.has_value());
+    EXPECT_EQ(x->header.as_string(), "\x08");
+    EXPECT_EQ(x->payload.as_string(), payload);
+
+    // Truncated varint
+    EXPECT_FALSE(parser.next().has_value());
+    EXPECT_EQ(parser.consumed(), data.size() - 2);
+
+    const auto invalid = std::string(1, '\x01') + std::string(11, '\xFF');
+    EXPECT_THROWN_MESSAGE(
+        std::ignore = nova::frame_parser(nova::data_view(invalid), format).next(),
+        "Invalid frame length"
+    );
+}
+
+TEST(FrameParser, MaxFrameSize) {
+    auto format = Format;
+    format.max_frame_size = 8;
+
+    const auto data = "\x01\x00\x05Hello" "\x01\x00\x06"_data;
+    auto parser = nova::frame_parser{ data, format };
+    EXPECT_EQ(parser.next()->payload.as_string(), "Hello");
+    EXPECT_THROWN_MESSAGE(std::ignore = parser.next(), "Frame size is over the limit 8");
+}
+
+TEST(FrameParser, InvalidFormat) {
+    auto format = Format;
+    format.header_size = 2;
+    EXPECT_ASSERTION_FAIL(std::ignore = nova::frame_parser("abc"_data, format));
+}
+
+TEST(ConsumeFrames, StreamBuffer) {
+    auto buf = nova::stream_buffer{ 1024 };
+    EXPECT_EQ(buf.write("\x01\x00\x05Hello" "\x02\x00\x04No"_data), 13);
+
+    EXPECT_THAT(collect(buf, Format), testing::ElementsAre("Hello"));
+    EXPECT_EQ(buf.size(), 5);
+
+    EXPECT_EQ(buf.write("va"_data), 2);
+    EXPECT_THAT(collect(buf, Format), testing::ElementsAre("Nova"));
+    EXPECT_TRUE(buf.empty());
+    EXPECT_TRUE(collect(buf, Format).empty());
+}
+
+TEST(ConsumeFrames, RingBuffer) {
+    auto buf = nova::ring_buffer{ 1 };
+    for (std::uint8_t i = 0; i < 100; ++i) {
+        const auto frame = std::string{ '\x01', '\x00', static_cast<char>(i % 10) } + std::string(i % 10, 'a');
+        ASSERT_EQ(buf.write(nova::data_view(frame)), frame.size());
+    }
+
+    const auto frames = collect(buf, Format);
+    EXPECT_EQ(frames.size(), 100);
+    EXPECT_EQ(frames[99], "aaaaaaaaa");
+    EXPECT_TRUE(buf.empty());
+}
+
+TEST(ConsumeFrames, SegmentedBuffer) {
+    // Most of the frames span segments, some are longer than a segment
+    auto buf = nova::segmented_buffer{ 1024, std::make_shared<nova::segment_pool>(8) };
+    auto expected = std::vector<std::string>{ };
+    for (std::uint8_t i = 0; i < 30; ++i) {
+        const auto payload = std::string(i % 12, static_cast<char>('a' + i));
+        const auto frame = std::string{ '\x01', '\x00', static_cast<char>(payload.size()) } + payload;
+        ASSERT_EQ(buf.write(nova::data_view(frame)), frame.size());
+        expected.push_back(payload);
+    }
+    ASSERT_EQ(buf.write("\x02\x00\x0A" "abcdefg"_data), 10);
+
+    EXPECT_EQ(collect(buf, Format), expected);
+    EXPECT_EQ(buf.size(), 10);
+
+    ASSERT_EQ(buf.write("hij"_data), 3);
+    EXPECT_THAT(collect(buf, Format), testing::ElementsAre("abcdefghij"));
+    EXPECT_TRUE(buf.empty());
+}
+
+TEST(ConsumeFrames, ThrowingCallback) {
+    auto buf = nova::stream_buffer{ 1024 };
+    EXPECT_EQ(buf.write("\x01\x00\x01" "a" "\x01\x00\x01" "b" "\x01\x00\x01" "c"_data), 12);
+
+    EXPECT_THROW(
+        nova::consume_frames(buf, Format, [](const nova::frame& x) {
+            if (x.payload.as_string() == "b") {
+                throw std::runtime_error("b");
+            }
+        }),
+        std::runtime_error
+    );
+    EXPECT_EQ(buf.view().as_string(), std::string_view("\x01\x00\x01" "c", 4));
+}
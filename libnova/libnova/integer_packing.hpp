@@ -0,0 +1,333 @@
+/**
+ * Part of Nova C++ Library.
+ *
+ * Compact encoding of integer series, e.g., timestamps and counters.
+ *
+ * Every value is replaced by its difference from the previous one (delta),
+ * mapped to unsigned (zigzag), then blocks of 128 of them are bit-packed with
+ * the smallest width that holds their distance from the block minimum (frame
+ * of reference). Monotonic series with regular steps take a few bits per value
+ * instead of 8 bytes:
+ *
+ * ```cpp
+ * auto ser = nova::detail::serializer_context<>{ };
+ * nova::pack_integers(ser, timestamps);
+ *
+ * const auto xs = nova::unpack_integers<std::uint64_t>(ser.view());
+ *
+ * // Inside a deserializer
+ * deser.skip(nova::unpack_integers(deser.view(), 0, xs));
+ * ```
+ *
+ * Format (independent of the byte order of the context):
+ *
+ * - varint: number of values
+ * - varint: the first value, if there is any; the deltas start from it
+ * - every block of up to 128 values:
+ *   - 1 byte: bit width, 0-64
+ *   - varint: reference, the minimum of the zigzag encoded deltas
+ *   - payload: little endian 64-bit words of two interleaved lanes; the even
+ *     values are packed into the even words, the odd values into the odd ones
+ *
+ * The lanes let SSE2 unpack two values at once (in the spirit of SIMD-BP128).
+ */
+
+#pragma once
+
+#include <libnova/data.hpp>
+#include <libnova/error.hpp>
+#include <libnova/intrinsics.hpp>
+#include <libnova/std_extensions.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace nova {
+
+/**
+ * @brief   Integers that can be packed with `pack_integers()`.
+ */
+template <typename T>
+concept packable_integer = std::integral<T> and not std::same_as<T, bool>;
+
+namespace detail {
+
+    inline constexpr std::size_t PackBlockSize = 128;
+
+    /**
+     * @brief   Number of 64-bit words of a lane of `count` values of `width` bits.
+     */
+    [[nodiscard]] constexpr auto packed_lane_words(std::size_t count, std::size_t width) -> std::size_t {
+        return ((count + 1) / 2 * width + 63) / 64;
+    }
+
+    [[nodiscard]] constexpr auto width_mask(std::size_t width) -> std::uint64_t {
+        return width == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << width) - 1;
+    }
+
+    /**
+     * @brief   Pack `count` residuals of `width` bits into two interleaved lanes.
+     *
+     * `words` must be zero-initialized.
+     */
+    inline void pack_block(std::uint64_t* words, const std::uint64_t* src, std::size_t count, std::size_t width) {
+        if (width == 0) {
+            return;
+        }
+
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto lane = i % 2;
+            const auto bit = i / 2 * width;
+            const auto word = bit / 64;
+            const auto offset = bit % 64;
+
+            words[2 * word + lane] |= src[i] << offset;
+            if (offset + width > 64) {
+                words[2 * (word + 1) + lane] |= src[i] >> (64 - offset);
+            }
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * @brief   Unpack and decode a block value by value.
+     *
+     * @param prev  The last value of the previous block.
+     */
+    inline void unpack_block_portable(
+        std::uint64_t* out,
+        const std::byte* src,
+        std::size_t count,
+        std::size_t width,
+        std::uint64_t reference,
+        std::uint64_t prev
+    ) {
+        const auto mask = width_mask(width);
+
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto lane = i % 2;
+            const auto bit = i / 2 * width;
+            const auto word = bit / 64;
+            const auto offset = bit % 64;
+
+            auto x = std::uint64_t{ 0 };
+            if (width > 0) {
+                load_numbers<endian::little>(&x, src + 8 * (2 * word + lane), 1);
+                x >>= offset;
+                if (offset + width > 64) {
+                    auto high = std::uint64_t{ };
+                    load_numbers<endian::little>(&high, src + 8 * (2 * (word + 1) + lane), 1);
+                    x |= high << (64 - offset);
+                }
+            }
+            prev += static_cast<std::uint64_t>(zigzag_decode<std::int64_t>((x & mask) + reference));
+            out[i] = prev;
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+#if defined(__SSE2__)
+    /**
+     * @brief   Unpack and decode a block two values at a time, one from each
+     *          lane, with the same shifts.
+     *
+     * The words of both lanes are loaded only when a value crosses into them,
+     * and the running sum is carried over in both halves of a register. `out`
+     * must have room for an even number of values.
+     */
+    inline void unpack_block_sse2(
+        std::uint64_t* out,
+        const std::byte* src,
+        std::size_t count,
+        std::size_t width,
+        std::uint64_t reference,
+        std::uint64_t prev
+    ) {
+        const auto mask = _mm_set1_epi64x(static_cast<long long>(width_mask(width)));
+        const auto ref = _mm_set1_epi64x(static_cast<long long>(reference));
+        const auto one = _mm_set1_epi64x(1);
+        auto sum = _mm_set1_epi64x(static_cast<long long>(prev));
+
+        // NOLINTBEGIN(*reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic) | Unaligned SIMD loads and stores
+        const auto* end = src + 16 * packed_lane_words(count, width);
+        auto word = width == 0 ? _mm_setzero_si128() : _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        std::size_t offset = 0;
+
+        for (std::size_t i = 0; i < count; i += 2) {
+            auto x = _mm_srl_epi64(word, _mm_cvtsi64_si128(static_cast<long long>(offset)));
+            offset += width;
+            if (offset >= 64) {
+                offset -= 64;
+                src += 16;
+                word = src < end ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)) : _mm_setzero_si128();
+                // The bits above the width are masked out
+                x = _mm_or_si128(x, _mm_sll_epi64(word, _mm_cvtsi64_si128(static_cast<long long>(width - offset))));
+            }
+
+            x = _mm_add_epi64(_mm_and_si128(x, mask), ref);
+            x = _mm_xor_si128(_mm_srli_epi64(x, 1), _mm_sub_epi64(_mm_setzero_si128(), _mm_and_si128(x, one)));
+            x = _mm_add_epi64(x, _mm_slli_si128(x, 8));                         // [a, a + b]
+            sum = _mm_add_epi64(sum, x);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), sum);
+            sum = _mm_shuffle_epi32(sum, 0xEE);                                 // Broadcast the high half
+        }
+        // NOLINTEND(*reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+#endif
+
+    inline void unpack_block(
+        std::uint64_t* out,
+        const std::byte* src,
+        std::size_t count,
+        std::size_t width,
+        std::uint64_t reference,
+        std::uint64_t prev
+    ) {
+#if defined(__SSE2__)
+        unpack_block_sse2(out, src, count, width, reference, prev);
+#else
+        unpack_block_portable(out, src, count, width, reference, prev);
+#endif
+    }
+
+} // namespace detail
+
+/**
+ * @brief   Write a series of integers delta, zigzag and frame of reference
+ *          encoded, bit-packed in blocks of 128.
+ *
+ * Read it back with `unpack_integers()` into the same type.
+ */
+template <endian Endianness, typename Allocator, std::ranges::contiguous_range Range>
+    requires packable_integer<std::ranges::range_value_t<Range>>
+void pack_integers(detail::serializer_context<Endianness, Allocator>& ser, const Range& xs) {
+    using T = std::ranges::range_value_t<Range>;
+    using U = std::make_unsigned_t<T>;
+    using S = std::make_signed_t<T>;
+
+    const auto n = std::ranges::size(xs);
+    const auto* src = std::ranges::data(xs);
+    ser(varint{ n });
+    if (n == 0) {
+        return;
+    }
+    ser(varint{ *src });
+
+    auto residuals = std::array<std::uint64_t, detail::PackBlockSize>{ };
+    auto words = std::array<std::uint64_t, 2 * detail::PackBlockSize>{ };
+    auto payload = std::array<std::byte, sizeof(words)>{ };
+    auto prev = static_cast<U>(*src);
+
+    for (std::size_t begin = 0; begin < n; begin += detail::PackBlockSize) {
+        const auto count = std::min(detail::PackBlockSize, n - begin);
+
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto x = static_cast<U>(src[begin + i]);
+            residuals[i] = detail::zigzag_encode(static_cast<S>(static_cast<U>(x - prev)));
+            prev = x;
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        const auto [min, max] = std::minmax_element(residuals.begin(), std::next(residuals.begin(), static_cast<std::ptrdiff_t>(count)));
+        const auto reference = *min;
+        const auto width = static_cast<std::size_t>(64 - std::countl_zero(*max - reference));
+        for (std::size_t i = 0; i < count; ++i) {
+            residuals[i] -= reference;
+        }
+
+        const auto lane_words = detail::packed_lane_words(count, width);
+        std::fill_n(words.begin(), 2 * lane_words, 0);
+        detail::pack_block(words.data(), residuals.data(), count, width);
+        detail::store_numbers<endian::little>(payload.data(), words.data(), 2 * lane_words);
+
+        ser(static_cast<std::uint8_t>(width));
+        ser(varint{ reference });
+        ser(data_view{ payload.data(), 2 * lane_words * sizeof(std::uint64_t) });
+    }
+}
+
+/**
+ * @brief   Read a series of integers written by `pack_integers()` from `pos`
+ *          into `out`, replacing its content.
+ *
+ * @returns the number of bytes read.
+ * @throws  if the data is truncated or invalid.
+ */
+template <packable_integer T, endian E, bool B>
+auto unpack_integers(const detail::data_view<E, B>& data, std::size_t pos, std::vector<T>& out) -> std::size_t {
+    const auto begin = pos;
+    const auto [n, n_size] = data.template as_varint<std::size_t>(pos);
+    pos += n_size;
+
+    // Every block takes at least 2 bytes
+    const auto blocks = n / detail::PackBlockSize + (n % detail::PackBlockSize != 0 ? 1 : 0);
+    if (blocks > (data.size() - pos) / 2) {
+        throw exception("Invalid packed integer count {}: {}", n, detail::data_cursor{ begin, n_size, data.size() });
+    }
+
+    out.resize(n);
+    if (n == 0) {
+        return pos - begin;
+    }
+    const auto [first, first_size] = data.template as_varint<T>(pos);
+    pos += first_size;
+
+    auto block = std::array<std::uint64_t, detail::PackBlockSize>{ };
+    auto prev = static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<T>>(first));
+
+    for (std::size_t i = 0; i < n; i += detail::PackBlockSize) {
+        const auto count = std::min(detail::PackBlockSize, n - i);
+
+        const auto width = std::size_t{ data.template as_number<std::uint8_t>(pos) };
+        if (width > 64) {
+            throw exception("Invalid packed integer width {}: {}", width, detail::data_cursor{ pos, 1, data.size() });
+        }
+        const auto [reference, reference_size] = data.template as_varint<std::uint64_t>(pos + 1);
+        pos += 1 + reference_size;
+
+        const auto payload_size = 2 * detail::packed_lane_words(count, width) * sizeof(std::uint64_t);
+        const auto payload = data.checked(pos, payload_size);
+        pos += payload_size;
+
+        if constexpr (std::same_as<T, std::uint64_t>) {
+            if (count == detail::PackBlockSize) {
+                detail::unpack_block(std::next(out.data(), static_cast<std::ptrdiff_t>(i)), payload.ptr(), count, width, reference, prev);
+                prev = out[i + count - 1];
+                continue;
+            }
+        }
+
+        detail::unpack_block(block.data(), payload.ptr(), count, width, reference, prev);
+        prev = block[count - 1];
+        for (std::size_t j = 0; j < count; ++j) {
+            out[i + j] = static_cast<T>(block[j]);
+        }
+    }
+
+    return pos - begin;
+}
+
+/**
+ * @brief   Read a series of integers written by `pack_integers()` from `pos`.
+ *
+ * @throws  if the data is truncated or invalid.
+ */
+template <packable_integer T, endian E, bool B>
+[[nodiscard]] auto unpack_integers(const detail::data_view<E, B>& data, std::size_t pos = 0) -> std::vector<T> {
+    auto ret = std::vector<T>{ };
+    std::ignore = unpack_integers(data, pos, ret);
+    return ret;
+}
+
+} // namespace nova
@@ -0,0 +1,161 @@
+#define NOVA_RUNTIME_ASSERTIONS
+
+#include <libnova/data.hpp>
+#include <libnova/integer_packing.hpp>
+#include <libnova/test_utils.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+template <typename T>
+auto round_trip(const std::vector<T>& xs) -> std::vector<T> {
+    auto ser = nova::detail::serializer_context<>{ };
+    nova::pack_integers(ser, xs);
+    return nova::unpack_integers<T>(ser.view());
+}
+
+template <typename T>
+auto sample_series(std::size_t size) -> std::vector<T> {
+    auto ret = std::vector<T>(size);
+    auto x = std::uint64_t{ 0x0123'4567'89AB'CDEF };
+    for (std::size_t i = 0; i < size; ++i) {
+        x = x * 6364136223846793005U + 1442695040888963407U;
+        ret[i] = static_cast<T>(x >> (i % 64U));
+    }
+    return ret;
+}
+
+} // namespace
+
+template <typename T>
+class IntegerPacking : public testing::Test { };
+
+using IntegerPackingTypes = testing::Types<std::uint8_t, std::int16_t, std::uint32_t, std::int32_t, std::uint64_t, std::int64_t>;
+TYPED_TEST_SUITE(IntegerPacking, IntegerPackingTypes);
+
+TYPED_TEST(IntegerPacking, RoundTrip) {
+    using T = TypeParam;
+
+    for (const auto size : { 0U, 1U, 2U, 127U, 128U, 129U, 300U, 1000U }) {
+        const auto xs = sample_series<T>(size);
+        EXPECT_EQ(round_trip(xs), xs) << "Size=" << size;
+    }
+
+    const auto extremes = std::vector<T>{
+        std::numeric_limits<T>::min(), std::numeric_limits<T>::max(), std::numeric_limits<T>::min(), 0, std::numeric_limits<T>::max(),
+    };
+    EXPECT_EQ(round_trip(extremes), extremes);
+}
+
+TEST(IntegerPacking, Format) {
+    auto ser = nova::detail::serializer_context<>{ };
+
+    // First: 1 -> zigzag: 2; deltas: 0, 1, 1 -> zigzag: 0, 2, 2 -> reference: 0, width: 2
+    nova::pack_integers(ser, std::vector<std::int32_t>{ 1, 2, 3 });
+    EXPECT_EQ(ser.view().as_hex_string(), "03" "02" "02" "00" "0800000000000000" "0200000000000000");
+
+    // First: 10; deltas: 0, 2, -1 -> zigzag: 0, 4, 1 -> reference: 0, width: 3
+    ser.reset();
+    nova::pack_integers(ser, std::vector<std::uint64_t>{ 10, 12, 11 });
+    EXPECT_EQ(ser.view().as_hex_string(), "03" "0a" "03" "00" "0800000000000000" "0400000000000000");
+
+    // First: 7; delta: 0 -> reference: 0, width: 0, no payload
+    ser.reset();
+    nova::pack_integers(ser, std::vector<std::uint16_t>{ 7 });
+    EXPECT_EQ(ser.view().as_hex_string(), "01" "07" "00" "00");
+
+    ser.reset();
+    nova::pack_integers(ser, std::vector<std::uint16_t>{ });
+    EXPECT_EQ(ser.view().as_hex_string(), "00");
+}
+
+TEST(IntegerPacking, RegularSeriesIsCompact) {
+    auto timestamps = std::vector<std::uint64_t>(10'000);
+    for (std::size_t i = 0; i < timestamps.size(); ++i) {
+        timestamps[i] = 1'700'000'000'000'000 + i * 1'000'000 + (i * 7 % 13);
+    }
+
+    auto ser = nova::detail::serializer_context<>{ };
+    nova::pack_integers(ser, timestamps);
+    EXPECT_LT(ser.size(), timestamps.size() * sizeof(std::uint64_t) / 10);
+    EXPECT_EQ(nova::unpack_integers<std::uint64_t>(ser.view()), timestamps);
+}
+
+TEST(IntegerPacking, Deserializer) {
+    const auto xs = sample_series<std::int64_t>(200);
+
+    auto ser = nova::detail::serializer_context<nova::endian::little>{ };
+    ser(std::uint16_t{ 0xABCD });
+    nova::pack_integers(ser, xs);
+    ser(std::uint16_t{ 0x1234 });
+
+    auto deser = nova::detail::deserializer_context<nova::endian::little>{ ser.view() };
+    auto head = std::uint16_t{ };
+    auto ys = std::vector<std::int64_t>{ 1, 2, 3 };
+    auto tail = std::uint16_t{ };
+
+    deser(head);
+    deser.skip(nova::unpack_integers(deser.view(), 0, ys));
+    deser(tail);
+
+    EXPECT_EQ(head, 0xABCD);
+    EXPECT_EQ(ys, xs);
+    EXPECT_EQ(tail, 0x1234);
+    EXPECT_TRUE(deser.empty());
+}
+
+TEST(IntegerPacking, InvalidData) {
+    auto ser = nova::detail::serializer_context<>{ };
+    nova::pack_integers(ser, std::vector<std::uint64_t>{ 10, 12, 11 });
+    const auto data = ser.data();
+
+    const auto truncated = nova::data_view(data).subview(0, data.size() - 1);
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::unpack_integers<std::uint64_t>(truncated), "Out of bounds access");
+
+    auto wide = data;
+    wide[2] = std::byte{ 65 };
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::unpack_integers<std::uint64_t>(nova::data_view(wide)), "Invalid packed integer width 65: Pos=2 Len=1");
+
+    const auto too_many = nova::from_hex("ff01" "0000");
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::unpack_integers<std::uint64_t>(nova::data_view(too_many)), "Invalid packed integer count 255");
+}
+
+TEST(IntegerPacking, PortableSameAsSse2) {
+#if defined(__SSE2__)
+    auto residuals = std::array<std::uint64_t, nova::detail::PackBlockSize>{ };
+    auto words = std::array<std::uint64_t, 2 * nova::detail::PackBlockSize>{ };
+    auto expected = std::array<std::uint64_t, nova::detail::PackBlockSize>{ };
+    auto actual = std::array<std::uint64_t, nova::detail::PackBlockSize>{ };
+
+    const auto values = sample_series<std::uint64_t>(nova::detail::PackBlockSize);
+    for (std::size_t width = 0; width <= 64; ++width) {
+        for (const auto count : { std::size_t{ 1 }, std::size_t{ 77 }, nova::detail::PackBlockSize }) {
+            for (std::size_t i = 0; i < count; ++i) {
+                residuals[i] = values[i] & nova::detail::width_mask(width);
+            }
+            words.fill(0);
+            nova::detail::pack_block(words.data(), residuals.data(), count, width);
+
+            const auto size = 2 * nova::detail::packed_lane_words(count, width);
+            auto payload = std::vector<std::byte>(size * sizeof(std::uint64_t));
+            nova::detail::store_numbers<nova::endian::little>(payload.data(), words.data(), size);
+
+            nova::detail::unpack_block_portable(expected.data(), payload.data(), count, width, 3, 42);
+            nova::detail::unpack_block_sse2(actual.data(), payload.data(), count, width, 3, 42);
+            EXPECT_TRUE(std::equal(expected.begin(), std::next(expected.begin(), static_cast<std::ptrdiff_t>(count)), actual.begin()))
+                << "Width=" << width << " Count=" << count;
+        }
+    }
+#else
+    GTEST_SKIP() << "SSE2 is not available on this platform";
+#endif
+}
@@ -2,11 +2,28 @@
  * Part of Nova C++ Library.
  *
  * JSON API for uniform document handling.
+ *
+ * Documents can be exchanged as text, or as CBOR (RFC 8949) which is written
+ * into a `serializer_context` and read from a `data_view` directly, without
+ * formatting and parsing text:
+ *
+ * ```cpp
+ * auto ser = nova::serializer_context{ };
+ * doc.to_cbor(ser);                                   // or `ser(doc)`
+ *
+ * const auto copy = nova::json::from_cbor(ser.view());
+ * ```
+ *
+ * Integers are written in the shortest form, floating point numbers as
+ * single precision if it is exact, else as double precision. Tags are ignored
+ * when reading, and indefinite length items are not supported.
  */
 
 #pragma once
 
+#include <libnova/data.hpp>
 #include <libnova/error.hpp>
+#include <libnova/intrinsics.hpp>
 
 #include <fmt/format.h>
 
@@ -23,8 +40,16 @@
 #endif
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace nova {
 
@@ -58,6 +83,313 @@ private:
 
 };
 
+namespace detail {
+
+    /**
+     * @brief   Major types of CBOR data items.
+     */
+    enum class cbor_major : std::uint8_t {
+        unsigned_integer = 0,
+        negative_integer = 1,
+        bytes = 2,
+        text = 3,
+        array = 4,
+        map = 5,
+        tag = 6,
+        simple = 7,
+    };
+
+    inline constexpr std::size_t CborMaxDepth = 512;
+
+    /**
+     * @brief   Write the initial byte followed by `x` in big-endian.
+     */
+    template <typename T, endian Endianness, typename Allocator>
+    void cbor_write_initial(serializer_context<Endianness, Allocator>& ser, std::uint8_t initial, T x) {
+        auto buffer = std::array<std::byte, 1 + sizeof(T)>{ std::byte{ initial } };
+        store_numbers<endian::big>(std::next(buffer.data()), &x, 1);
+        ser(data_view{ buffer.data(), buffer.size() });
+    }
+
+    /**
+     * @brief   Write the head of a data item: the major type and the argument
+     *          in the shortest form.
+     */
+    template <endian Endianness, typename Allocator>
+    void cbor_write_head(serializer_context<Endianness, Allocator>& ser, cbor_major major, std::uint64_t arg) {
+        const auto type = static_cast<std::uint8_t>(static_cast<std::uint8_t>(major) << 5U);
+        if (arg < 24) {
+            ser(static_cast<std::uint8_t>(type | arg));
+        }
+        else if (arg <= std::numeric_limits<std::uint8_t>::max()) {
+            cbor_write_initial(ser, static_cast<std::uint8_t>(type | 24U), static_cast<std::uint8_t>(arg));
+        }
+        else if (arg <= std::numeric_limits<std::uint16_t>::max()) {
+            cbor_write_initial(ser, static_cast<std::uint8_t>(type | 25U), static_cast<std::uint16_t>(arg));
+        }
+        else if (arg <= std::numeric_limits<std::uint32_t>::max()) {
+            cbor_write_initial(ser, static_cast<std::uint8_t>(type | 26U), static_cast<std::uint32_t>(arg));
+        }
+        else {
+            cbor_write_initial(ser, static_cast<std::uint8_t>(type | 27U), arg);
+        }
+    }
+
+    /**
+     * @brief   Write a floating point number in single precision if it is
+     *          exact, else in double precision.
+     */
+    template <endian Endianness, typename Allocator>
+    void cbor_write_float(serializer_context<Endianness, Allocator>& ser, double x) {
+        // Narrowing a number out of the range is undefined
+        const auto in_range = std::isinf(x) or std::abs(x) <= static_cast<double>(std::numeric_limits<float>::max());
+        if (in_range and static_cast<double>(static_cast<float>(x)) == x) {
+            cbor_write_initial(ser, 0xFA, static_cast<float>(x));
+        }
+        else {
+            cbor_write_initial(ser, 0xFB, x);
+        }
+    }
+
+    /**
+     * @brief   Write a document as a CBOR data item.
+     */
+    template <endian Endianness, typename Allocator>
+    void cbor_write(serializer_context<Endianness, Allocator>& ser, const nlohmann::json& x) {
+        using value_t = nlohmann::json::value_t;
+
+        switch (x.type()) {
+            case value_t::null:
+            case value_t::discarded:
+                ser(std::uint8_t{ 0xF6 });
+                break;
+            case value_t::boolean:
+                ser(x.get<bool>() ? std::uint8_t{ 0xF5 } : std::uint8_t{ 0xF4 });
+                break;
+            case value_t::number_unsigned:
+                cbor_write_head(ser, cbor_major::unsigned_integer, x.get<std::uint64_t>());
+                break;
+            case value_t::number_integer: {
+                const auto value = x.get<std::int64_t>();
+                if (value >= 0) {
+                    cbor_write_head(ser, cbor_major::unsigned_integer, static_cast<std::uint64_t>(value));
+                }
+                else {
+                    cbor_write_head(ser, cbor_major::negative_integer, static_cast<std::uint64_t>(-(value + 1)));
+                }
+                break;
+            }
+            case value_t::number_float:
+                cbor_write_float(ser, x.get<double>());
+                break;
+            case value_t::string: {
+                const auto& str = x.get_ref<const nlohmann::json::string_t&>();
+                cbor_write_head(ser, cbor_major::text, str.size());
+                ser(std::string_view{ str });
+                break;
+            }
+            case value_t::binary: {
+                const auto& bin = x.get_binary();
+                cbor_write_head(ser, cbor_major::bytes, bin.size());
+                ser(data_view{ bin.data(), bin.size() });
+                break;
+            }
+            case value_t::array:
+                cbor_write_head(ser, cbor_major::array, x.size());
+                for (const auto& item : x) {
+                    cbor_write(ser, item);
+                }
+                break;
+            case value_t::object:
+                cbor_write_head(ser, cbor_major::map, x.size());
+                for (const auto& [key, value] : x.items()) {
+                    cbor_write_head(ser, cbor_major::text, key.size());
+                    ser(std::string_view{ key });
+                    cbor_write(ser, value);
+                }
+                break;
+        }
+    }
+
+    /**
+     * @brief   Reads CBOR data items into documents.
+     */
+    template <bool RuntimeBoundCheck>
+    class cbor_reader {
+    public:
+        template <endian E>
+        [[nodiscard]] cbor_reader(const data_view<E, RuntimeBoundCheck>& data, std::size_t pos)
+            : m_data(data.ptr(), data.size())
+            , m_pos(pos)
+        {}
+
+        /**
+         * @brief   Read a data item and advance the position past it.
+         *
+         * @throws  if the data is truncated or invalid, or the item is not
+         *          supported.
+         */
+        [[nodiscard]] auto read(std::size_t depth = 0) -> nlohmann::json {
+            if (depth > CborMaxDepth) {
+                throw exception("CBOR nesting is deeper than {}: {}", CborMaxDepth, data_cursor{ m_pos, 1, m_data.size() });
+            }
+
+            const auto start = m_pos;
+            const auto initial = m_data.template as_number<std::uint8_t>(m_pos);
+            const auto major = static_cast<cbor_major>(initial >> 5U);
+            const auto info = static_cast<std::uint8_t>(initial & 0x1FU);
+            ++m_pos;
+
+            if (major == cbor_major::simple) {
+                return read_simple(start, info);
+            }
+
+            const auto arg = read_argument(start, info);
+            switch (major) {
+                case cbor_major::unsigned_integer:
+                    return arg;
+                case cbor_major::negative_integer:
+                    if (arg > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+                        throw exception("CBOR integer is out of range: {}", data_cursor{ start, m_pos - start, m_data.size() });
+                    }
+                    return -static_cast<std::int64_t>(arg) - 1;
+                case cbor_major::bytes: {
+                    const auto bytes = take(start, arg);
+                    const auto* ptr = reinterpret_cast<const std::uint8_t*>(bytes.ptr());               // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast) | Bytes as unsigned char
+                    return nlohmann::json::binary(std::vector<std::uint8_t>(ptr, std::next(ptr, static_cast<std::ptrdiff_t>(bytes.size()))));
+                }
+                case cbor_major::text:
+                    return read_text(start, arg);
+                case cbor_major::array: {
+                    length_check(start, arg);
+                    auto ret = nlohmann::json::array();
+                    auto& items = ret.get_ref<nlohmann::json::array_t&>();
+                    items.reserve(arg);
+                    for (std::uint64_t i = 0; i < arg; ++i) {
+                        items.push_back(read(depth + 1));
+                    }
+                    return ret;
+                }
+                case cbor_major::map: {
+                    length_check(start, arg);
+                    auto ret = nlohmann::json::object();
+                    auto& members = ret.get_ref<nlohmann::json::object_t&>();
+                    for (std::uint64_t i = 0; i < arg; ++i) {
+                        auto key = read_key();
+                        // Keys are written in order, so they are appended as a rule
+                        members.insert_or_assign(members.end(), std::move(key), read(depth + 1));
+                    }
+                    return ret;
+                }
+                case cbor_major::tag:
+                    return read(depth + 1);
+                default:
+                    nova::unreachable();
+            }
+        }
+
+        /**
+         * @brief   Position after the items read.
+         */
+        [[nodiscard]] auto pos() const -> std::size_t { return m_pos; }
+
+    private:
+        data_view<endian::big, RuntimeBoundCheck> m_data;
+        std::size_t m_pos;
+
+        [[nodiscard]] auto read_argument(std::size_t start, std::uint8_t info) -> std::uint64_t {
+            auto ret = std::uint64_t{ info };
+            switch (info) {
+                case 24: ret = read_number<std::uint8_t>();  break;
+                case 25: ret = read_number<std::uint16_t>(); break;
+                case 26: ret = read_number<std::uint32_t>(); break;
+                case 27: ret = read_number<std::uint64_t>(); break;
+                case 31:
+                    throw exception("Unsupported CBOR indefinite length: {}", data_cursor{ start, 1, m_data.size() });
+                default:
+                    if (info > 27) {
+                        throw exception("Invalid CBOR additional information {}: {}", info, data_cursor{ start, 1, m_data.size() });
+                    }
+            }
+            return ret;
+        }
+
+        template <typename T>
+        [[nodiscard]] auto read_number() -> T {
+            const auto ret = m_data.template as_number<T>(m_pos);
+            m_pos += sizeof(T);
+            return ret;
+        }
+
+        [[nodiscard]] auto read_simple(std::size_t start, std::uint8_t info) -> nlohmann::json {
+            switch (info) {
+                case 20: return false;
+                case 21: return true;
+                case 22:
+                case 23: return nullptr;
+                case 25: return half_to_double(read_number<std::uint16_t>());
+                case 26: return static_cast<double>(std::bit_cast<float>(read_number<std::uint32_t>()));
+                case 27: return std::bit_cast<double>(read_number<std::uint64_t>());
+                default:
+                    throw exception("Unsupported CBOR simple value {}: {}", info, data_cursor{ start, 1, m_data.size() });
+            }
+        }
+
+        [[nodiscard]] auto read_key() -> std::string {
+            const auto start = m_pos;
+            const auto initial = m_data.template as_number<std::uint8_t>(m_pos);
+            if (static_cast<cbor_major>(initial >> 5U) != cbor_major::text) {
+                throw exception("Unsupported CBOR map key, only text is supported: {}", data_cursor{ start, 1, m_data.size() });
+            }
+            ++m_pos;
+            return read_text(start, read_argument(start, static_cast<std::uint8_t>(initial & 0x1FU)));
+        }
+
+        [[nodiscard]] auto read_text(std::size_t start, std::uint64_t length) -> std::string {
+            const auto text = take(start, length);
+            return std::string(text.as_string(0, text.size()));
+        }
+
+        [[nodiscard]] auto take(std::size_t start, std::uint64_t length) -> data_view<endian::big, false> {
+            length_check(start, length);
+            const auto ret = m_data.checked(m_pos, length);
+            m_pos += ret.size();
+            return ret;
+        }
+
+        /**
+         * @brief   Every byte and item takes at least a byte; reject longer
+         *          lengths before allocating for them.
+         */
+        void length_check(std::size_t start, std::uint64_t length) const {
+            if (length > m_data.size() - m_pos) {
+                throw exception("Invalid CBOR length {}: {}", length, data_cursor{ start, m_pos - start, m_data.size() });
+            }
+        }
+
+        /**
+         * @brief   Decode a half precision floating point number (RFC 8949, Appendix D).
+         */
+        [[nodiscard]] static auto half_to_double(std::uint16_t half) -> double {
+            const auto exponent = (half >> 10U) & 0x1FU;
+            const auto mantissa = half & 0x3FFU;
+
+            auto ret = 0.0;
+            if (exponent == 0) {
+                ret = std::ldexp(mantissa, -24);
+            }
+            else if (exponent != 31) {
+                ret = std::ldexp(mantissa + 1024, static_cast<int>(exponent) - 25);
+            }
+            else {
+                ret = mantissa == 0 ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+            }
+            return (half & 0x8000U) != 0 ? -ret : ret;
+        }
+    };
+
+} // namespace detail
+
 class json {
 public:
     [[nodiscard]] explicit json(const std::string& content) try
@@ -71,6 +403,27 @@ public:
         return m_data.dump(indent);
     }
 
+    /**
+     * @brief   Write the document as CBOR into `ser`.
+     */
+    template <endian Endianness, typename Allocator>
+    void to_cbor(detail::serializer_context<Endianness, Allocator>& ser) const {
+        detail::cbor_write(ser, m_data);
+    }
+
+    /**
+     * @brief   Read a CBOR document from `pos`; the data after it is ignored.
+     *
+     * @throws  if the data is truncated or invalid, or it is not supported.
+     */
+    template <endian Endianness, bool RuntimeBoundCheck>
+    [[nodiscard]] static auto from_cbor(const detail::data_view<Endianness, RuntimeBoundCheck>& data, std::size_t pos = 0) -> json {
+        auto reader = detail::cbor_reader{ data, pos };
+        auto ret = json();
+        ret.set(reader.read());
+        return ret;
+    }
+
     template <typename R> requires std::is_fundamental_v<R>
     [[nodiscard]] R lookup(const std::string& path) const {
         return m_data.at(make_json_pointer(path)).template get<R>();
@@ -111,6 +464,8 @@ public:
     }
 
 private:
+    friend struct deserializer<json>;
+
     nlohmann::json m_data;
 
     /**
@@ -125,6 +480,10 @@ private:
         m_data = json_object;
     }
 
+    void set(nlohmann::json&& json_object) {
+        m_data = std::move(json_object);
+    }
+
     [[nodiscard]] static auto make_json_pointer(const std::string& path)
             -> nlohmann::json::json_pointer
     {
@@ -132,4 +491,25 @@ private:
     }
 };
 
+/**
+ * @brief   A document is serialized as CBOR, which is self-delimiting.
+ */
+template <>
+struct serializer<json> {
+    template <endian Endianness, typename Allocator>
+    void operator()(detail::serializer_context<Endianness, Allocator>& ser, const json& x) {
+        x.to_cbor(ser);
+    }
+};
+
+template <>
+struct deserializer<json> {
+    template <endian Endianness, bool RuntimeBoundCheck>
+    void operator()(detail::deserializer_context<Endianness, RuntimeBoundCheck>& deser, json& x) {
+        auto reader = detail::cbor_reader{ deser.view(), 0 };
+        x.set(reader.read());
+        deser.skip(reader.pos());
+    }
+};
+
 } // namespace nova
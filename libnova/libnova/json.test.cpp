@@ -1,10 +1,14 @@
+#include <libnova/data.hpp>
 #include <libnova/error.hpp>
 #include <libnova/json.hpp>
+#include <libnova/test_utils.hpp>
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <cstdint>
 #include <sstream>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -104,3 +108,96 @@ TEST(Json, LookupDefault) {
     EXPECT_EQ(json.lookup<int>("nokey", 1), 1);
     EXPECT_THAT(json.lookup<Array>("nolist", Array{ 1, 2 }), ElementsAre(1, 2));
 }
+
+namespace {
+
+auto cbor_hex(const std::string& text) -> std::string {
+    auto ser = nova::serializer_context{ };
+    nova::json(text).to_cbor(ser);
+    return ser.view().as_hex_string();
+}
+
+auto from_cbor_hex(const std::string& hex) -> std::string {
+    const auto data = nova::from_hex(hex);
+    return nova::json::from_cbor(nova::data_view(data)).dump();
+}
+
+} // namespace
+
+TEST(Json, CborRoundTrip) {
+    const auto doc = nova::json(input);
+
+    auto ser = nova::serializer_context_le{ };
+    doc.to_cbor(ser);
+    EXPECT_EQ(nova::json::from_cbor(ser.view()).dump(), doc.dump());
+
+    const auto edges = nova::json(R"([ -9223372036854775808, 18446744073709551615, -1e300, 0.1, "", {}, [], [[[]]] ])");
+    ser.reset();
+    edges.to_cbor(ser);
+    EXPECT_EQ(nova::json::from_cbor(ser.view()).dump(), edges.dump());
+}
+
+TEST(Json, CborFormat) {
+    EXPECT_EQ(cbor_hex("0"), "00");
+    EXPECT_EQ(cbor_hex("23"), "17");
+    EXPECT_EQ(cbor_hex("24"), "1818");
+    EXPECT_EQ(cbor_hex("500"), "1901f4");
+    EXPECT_EQ(cbor_hex("1000000"), "1a000f4240");
+    EXPECT_EQ(cbor_hex("1000000000000"), "1b000000e8d4a51000");
+    EXPECT_EQ(cbor_hex("-1"), "20");
+    EXPECT_EQ(cbor_hex("-1000"), "3903e7");
+    EXPECT_EQ(cbor_hex("1.5"), "fa3fc00000");
+    EXPECT_EQ(cbor_hex("0.1"), "fb3fb999999999999a");
+    EXPECT_EQ(cbor_hex(R"({ "a": [ true, false, null, "xy" ] })"), "a1" "6161" "84" "f5" "f4" "f6" "627879");
+
+    EXPECT_EQ(from_cbor_hex("f93c00"), "1.0");
+    EXPECT_EQ(from_cbor_hex("f90001"), "5.960464477539063e-08");
+    EXPECT_EQ(from_cbor_hex("f9fc00"), "null");                 // -Infinity has no text form
+    EXPECT_EQ(from_cbor_hex("c11a514b67b0"), "1363896240");     // Tag 1, epoch time
+    EXPECT_EQ(from_cbor_hex("f7"), "null");                     // Undefined
+    EXPECT_EQ(from_cbor_hex("4201ff"), R"({"bytes":[1,255],"subtype":null})");
+}
+
+TEST(Json, CborDeserializer) {
+    const auto doc = nova::json(input);
+
+    auto ser = nova::serializer_context_be{ };
+    ser(std::uint16_t{ 0xABCD });
+    ser(doc);
+    ser(std::uint16_t{ 0x1234 });
+
+    auto deser = nova::deserializer_context_be{ ser.view() };
+    auto head = std::uint16_t{ };
+    auto copy = nova::json("null");
+    auto tail = std::uint16_t{ };
+    deser(head);
+    deser(copy);
+    deser(tail);
+
+    EXPECT_EQ(head, 0xABCD);
+    EXPECT_EQ(copy.dump(), doc.dump());
+    EXPECT_EQ(tail, 0x1234);
+    EXPECT_TRUE(deser.empty());
+}
+
+TEST(Json, CborInvalidData) {
+    auto ser = nova::serializer_context{ };
+    nova::json(input).to_cbor(ser);
+    const auto truncated = ser.view().subview(0, ser.size() - 1);
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::json::from_cbor(truncated), "Invalid CBOR length 3");
+    EXPECT_THROWN_MESSAGE(std::ignore = from_cbor_hex("1901"), "Out of bounds access");
+
+    EXPECT_THROWN_MESSAGE(std::ignore = from_cbor_hex("9f01ff"), "Unsupported CBOR indefinite length: Pos=0 Len=1");
+    EXPECT_THROWN_MESSAGE(std::ignore = from_cbor_hex("1c"), "Invalid CBOR additional information 28: Pos=0 Len=1");
+    EXPECT_THROWN_MESSAGE(std::ignore = from_cbor_hex("e0"), "Unsupported CBOR simple value 0");
+    EXPECT_THROWN_MESSAGE(std::ignore = from_cbor_hex("a10101"), "Unsupported CBOR map key, only text is supported: Pos=1 Len=1");
+    EXPECT_THROWN_MESSAGE(std::ignore = from_cbor_hex("9a7fffffff00"), "Invalid CBOR length 2147483647: Pos=0 Len=5");
+    EXPECT_THROWN_MESSAGE(std::ignore = from_cbor_hex("3bffffffffffffffff"), "CBOR integer is out of range: Pos=0 Len=9");
+
+    auto nested = std::string{ };
+    for (int i = 0; i < 600; ++i) {
+        nested += "81";
+    }
+    nested += "00";
+    EXPECT_THROWN_MESSAGE(std::ignore = from_cbor_hex(nested), "CBOR nesting is deeper than 512");
+}
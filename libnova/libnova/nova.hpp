@@ -8,11 +8,17 @@
 
 #include <libnova/details/version.hpp>
 
+#include <libnova/bit_fields.hpp>
+#include <libnova/bit_stream.hpp>
+#include <libnova/checksum.hpp>
 #include <libnova/color.hpp>
 #include <libnova/data.hpp>
 #include <libnova/error.hpp>
 #include <libnova/expected.hpp>
 #include <libnova/flat_map.hpp>
+#include <libnova/float_packing.hpp>
+#include <libnova/framing.hpp>
+#include <libnova/integer_packing.hpp>
 #include <libnova/intrinsics.hpp>
 #include <libnova/io.hpp>
 #include <libnova/json.hpp>
@@ -21,6 +27,9 @@
 #include <libnova/not_null.hpp>
 #include <libnova/parse.hpp>
 #include <libnova/random.hpp>
+#include <libnova/record_view.hpp>
+#include <libnova/ring_buffer.hpp>
+#include <libnova/segmented_buffer.hpp>
 #include <libnova/static_string.hpp>
 #include <libnova/std_extensions.hpp>
 #include <libnova/system.hpp>
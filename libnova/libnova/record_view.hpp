@@ -0,0 +1,229 @@
+/**
+ * Part of Nova C++ Library.
+ *
+ * Typed overlay views of fixed layout records in binary data.
+ *
+ * The layout is described at compile-time, and the fields are accessed by
+ * name. The bounds are checked once for the whole record, then every access
+ * is a single load (and byte swap) at a constant offset:
+ *
+ * ```cpp
+ * using trade = nova::record_layout<
+ *     nova::field<"id",        std::uint32_t, 0>,
+ *     nova::field<"price",     std::int64_t,  4>,
+ *     nova::field<"timestamp", std::uint64_t, 12, nova::endian::little>
+ * >;
+ *
+ * const auto x = nova::record_view<trade>{ view, pos };
+ * x.get<"price">();
+ *
+ * for (const auto& x : nova::as_records<trade>(view, pos, count)) {
+ *     ...
+ * }
+ * ```
+ *
+ * Fields can be integers, enums or floating point numbers.
+ */
+
+#pragma once
+
+#include <libnova/data.hpp>
+#include <libnova/error.hpp>
+#include <libnova/static_string.hpp>
+#include <libnova/std_extensions.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+
+namespace nova {
+
+template <typename T>
+concept record_field_type = std::is_integral_v<T> or std::is_enum_v<T> or std::is_floating_point_v<T>;
+
+/**
+ * @brief   A field of a record at a fixed offset in bytes.
+ */
+template <static_string Name, record_field_type T, std::size_t Offset, endian Endianness = endian::big>
+struct field {
+    using type = T;
+
+    static constexpr auto name = Name;
+    static constexpr auto offset = Offset;
+    static constexpr auto endianness = Endianness;
+    static constexpr auto end = Offset + sizeof(T);
+};
+
+namespace detail {
+
+    template <typename T>
+    struct is_field : std::false_type {};
+
+    template <static_string Name, typename T, std::size_t Offset, endian Endianness>
+    struct is_field<field<Name, T, Offset, Endianness>> : std::true_type {};
+
+    /**
+     * @brief   Load a number in the given byte order from unaligned memory.
+     */
+    template <typename T, endian Endianness>
+    [[nodiscard]] auto load_field(const std::byte* src) -> T {
+        if constexpr (std::is_enum_v<T>) {
+            return static_cast<T>(load_field<std::underlying_type_t<T>, Endianness>(src));
+        }
+        else if constexpr (std::is_floating_point_v<T>) {
+            using U = std::conditional_t<sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+            static_assert(sizeof(T) == sizeof(U), "Unsupported floating point type");
+            return std::bit_cast<T>(load_field<U, Endianness>(src));
+        }
+        else {
+            auto ret = T{ };
+            std::memcpy(&ret, src, sizeof(T));
+            if constexpr (Endianness != endian::native and sizeof(T) > 1) {
+                ret = nova::byteswap(ret);
+            }
+            return ret;
+        }
+    }
+
+} // namespace detail
+
+/**
+ * @brief   Compile-time description of a record.
+ *
+ * The size of the record is the end of its last field; see `padded_layout`
+ * for records with padding at the end.
+ */
+template <typename ...Fields>
+    requires (detail::is_field<Fields>::value and ...)
+struct record_layout {
+    using fields = std::tuple<Fields...>;
+
+    static constexpr std::size_t size = std::max({ std::size_t{ 0 }, Fields::end... });
+
+    /**
+     * @brief   Index of the field called `Name`, or the number of fields if
+     *          there is none.
+     */
+    template <static_string Name>
+    static constexpr std::size_t index_of = []() {
+        std::size_t ret = sizeof...(Fields);
+        std::size_t i = 0;
+        const auto match = [&](bool same_name) {
+            if (same_name and ret == sizeof...(Fields)) {
+                ret = i;
+            }
+            ++i;
+        };
+        (match(Fields::name == Name), ...);
+        return ret;
+    }();
+
+    template <static_string Name>
+        requires (index_of<Name> < sizeof...(Fields))
+    using field_of = std::tuple_element_t<index_of<Name>, fields>;
+};
+
+/**
+ * @brief   Record layout with padding at the end up to `Size` bytes.
+ */
+template <typename Layout, std::size_t Size>
+    requires (Size >= Layout::size)
+struct padded_layout : Layout {
+    static constexpr std::size_t size = Size;
+};
+
+/**
+ * @brief   Lightweight typed view of a single record.
+ *
+ * NOTE: it is a non-owning view like `data_view`.
+ */
+template <typename Layout>
+class record_view {
+    static_assert(Layout::size > 0, "Empty record layout");
+
+public:
+    /**
+     * @brief   View of the record at `pos`.
+     *
+     * @throws  if the record is out of bounds and `RuntimeBoundCheck` is on,
+     *          else asserts.
+     */
+    template <endian E, bool B>
+    [[nodiscard]] explicit record_view(const detail::data_view<E, B>& data, std::size_t pos = 0)
+        : m_data(data.checked(pos, Layout::size).ptr())
+    {}
+
+    /**
+     * @brief   View of a record without any bound check; `data` must point to
+     *          at least `Layout::size` bytes.
+     */
+    [[nodiscard]] static auto unchecked(const std::byte* data) -> record_view {
+        return record_view{ data };
+    }
+
+    [[nodiscard]] static constexpr auto size() -> std::size_t { return Layout::size; }
+
+    /**
+     * @brief   Value of the field called `Name`.
+     */
+    template <static_string Name>
+    [[nodiscard]] auto get() const -> typename Layout::template field_of<Name>::type {
+        using field_type = typename Layout::template field_of<Name>;
+        return detail::load_field<typename field_type::type, field_type::endianness>(
+            std::next(m_data, static_cast<std::ptrdiff_t>(field_type::offset))
+        );
+    }
+
+    /**
+     * @brief   The bytes of the record.
+     */
+    [[nodiscard]] auto view() const -> data_view { return { m_data, Layout::size }; }
+
+private:
+    const std::byte* m_data;
+
+    [[nodiscard]] explicit record_view(const std::byte* data)
+        : m_data(data)
+    {}
+};
+
+/**
+ * @brief   Random access range of `count` consecutive records from `pos`.
+ *
+ * The bounds are checked once for all the records.
+ *
+ * @param stride    Distance between the records, at least the record size.
+ */
+template <typename Layout, endian E, bool B>
+[[nodiscard]] auto as_records(
+    const detail::data_view<E, B>& data,
+    std::size_t pos,
+    std::size_t count,
+    std::size_t stride = Layout::size
+) {
+    nova_assert(stride >= Layout::size);
+    nova_assert(count == 0 or stride <= std::numeric_limits<std::size_t>::max() / count);
+
+    const auto* base = data.checked(pos, count == 0 ? 0 : (count - 1) * stride + Layout::size).ptr();
+    return std::views::iota(std::size_t{ 0 }, count)
+         | std::views::transform([base, stride](std::size_t i) {
+               return record_view<Layout>::unchecked(std::next(base, static_cast<std::ptrdiff_t>(i * stride)));
+           });
+}
+
+/**
+ * @brief   All the complete records in the data from `pos`.
+ */
+template <typename Layout, endian E, bool B>
+[[nodiscard]] auto as_records(const detail::data_view<E, B>& data, std::size_t pos = 0) {
+    const auto count = pos < data.size() ? (data.size() - pos) / Layout::size : 0;
+    return as_records<Layout>(data, std::min(pos, data.size()), count);
+}
+
+} // namespace nova
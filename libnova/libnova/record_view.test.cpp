@@ -0,0 +1,119 @@
+#define NOVA_RUNTIME_ASSERTIONS
+
+#include <libnova/data.hpp>
+#include <libnova/record_view.hpp>
+#include <libnova/test_utils.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+using namespace nova::literals;
+
+namespace {
+
+enum class side : std::uint8_t { buy = 1, sell = 2 };
+
+using trade = nova::record_layout<
+    nova::field<"side",      side,          0>,
+    nova::field<"id",        std::uint32_t, 1>,
+    nova::field<"price",     std::int64_t,  5>,
+    nova::field<"quantity",  float,         13>,
+    nova::field<"timestamp", std::uint64_t, 17, nova::endian::little>
+>;
+
+auto sample_trade(std::uint32_t id) -> nova::bytes {
+    auto ser = nova::serializer_context{ };
+    ser(std::uint8_t{ 2 });
+    ser(id);
+    ser(static_cast<std::uint64_t>(std::int64_t{ -1000 } * id));
+    ser(std::bit_cast<std::uint32_t>(1.5F));
+
+    auto ret = ser.release();
+    const auto timestamp = nova::serialize<nova::endian::little>(std::uint64_t{ 0x0102'0304'0506'0708 } + id);
+    ret.insert(ret.end(), timestamp.begin(), timestamp.end());
+    return ret;
+}
+
+} // namespace
+
+TEST(RecordLayout, Fields) {
+    static_assert(trade::size == 25);
+    static_assert(trade::index_of<"id"> == 1);
+    static_assert(trade::index_of<"unknown"> == 5);
+    static_assert(std::is_same_v<trade::field_of<"price">::type, std::int64_t>);
+    static_assert(nova::padded_layout<trade, 32>::size == 32);
+    static_assert(nova::padded_layout<trade, 32>::index_of<"price"> == 2);
+}
+
+TEST(RecordView, Get) {
+    const auto data = sample_trade(7);
+    const auto x = nova::record_view<trade>{ nova::data_view(data) };
+
+    EXPECT_EQ(x.get<"side">(), side::sell);
+    EXPECT_EQ(x.get<"id">(), 7);
+    EXPECT_EQ(x.get<"price">(), -7000);
+    EXPECT_EQ(x.get<"quantity">(), 1.5F);
+    EXPECT_EQ(x.get<"timestamp">(), 0x0102'0304'0506'070F);
+    EXPECT_EQ(x.view().size(), trade::size);
+}
+
+TEST(RecordView, SameAsDataView) {
+    const auto data = sample_trade(0x1234'5678);
+    const auto view = nova::data_view(data);
+    const auto x = nova::record_view<trade>{ view };
+
+    EXPECT_EQ(x.get<"id">(), view.as_number<std::uint32_t>(1));
+    EXPECT_EQ(x.get<"price">(), view.as_number<std::int64_t>(5));
+    EXPECT_EQ(x.get<"timestamp">(), nova::data_view_le(data).as_number<std::uint64_t>(17));
+}
+
+TEST(RecordView, OutOfBounds) {
+    const auto data = sample_trade(1);
+    const auto view = nova::data_view(data);
+
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::record_view<trade>(view, 1), "Out of bounds access: Pos=1 Len=25 End=26 \\(Size=25\\)");
+    EXPECT_ASSERTION_FAIL(std::ignore = nova::record_view<trade>(nova::detail::data_view<nova::endian::big, false>(data), 1));
+}
+
+TEST(AsRecords, Iterate) {
+    auto data = nova::bytes{ std::byte{ 0xFF } };
+    for (std::uint32_t i = 0; i < 100; ++i) {
+        const auto x = sample_trade(i);
+        data.insert(data.end(), x.begin(), x.end());
+    }
+    const auto view = nova::data_view(data);
+
+    const auto records = nova::as_records<trade>(view, 1, 100);
+    EXPECT_EQ(std::ranges::size(records), 100);
+    EXPECT_EQ(records[42].get<"id">(), 42);
+
+    std::uint32_t expected = 0;
+    for (const auto& x : records) {
+        EXPECT_EQ(x.get<"id">(), expected);
+        EXPECT_EQ(x.get<"price">(), -1000 * static_cast<std::int64_t>(expected));
+        ++expected;
+    }
+
+    EXPECT_EQ(std::ranges::size(nova::as_records<trade>(view, 1)), 100);
+    EXPECT_EQ(std::ranges::size(nova::as_records<trade>(view, 2)), 99);
+    EXPECT_EQ(std::ranges::size(nova::as_records<trade>(view, 10'000)), 0);
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::as_records<trade>(view, 2, 100), "Out of bounds access");
+}
+
+TEST(AsRecords, Stride) {
+    using pair = nova::record_layout<
+        nova::field<"a", std::uint16_t, 0>,
+        nova::field<"b", std::uint8_t, 2>
+    >;
+    const auto data = "\x00\x01\x02." "\x00\x03\x04." "\x00\x05\x06"_data;
+
+    const auto records = nova::as_records<pair>(data, 0, 3, 4);
+    EXPECT_EQ(records[2].get<"a">(), 5);
+    EXPECT_EQ(records[2].get<"b">(), 6);
+    EXPECT_THROWN_MESSAGE(std::ignore = nova::as_records<pair>(data, 1, 3, 4), "Out of bounds access");
+}
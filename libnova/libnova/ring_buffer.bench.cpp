@@ -0,0 +1,122 @@
+#include <libnova/data.hpp>
+#include <libnova/ring_buffer.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+
+namespace {
+
+constexpr std::size_t Capacity = 64 * 1024;
+
+/**
+ * Keeps half of the buffer unread all the time, like a socket buffer that is
+ * never fully drained.
+ */
+template <typename Buffer>
+void streaming(benchmark::State& state, Buffer& buf) {
+    const auto chunk = std::string(static_cast<std::size_t>(state.range(0)), 'a');
+    const auto backlog = std::string(Capacity / 2, 'b');
+    std::ignore = buf.write(nova::data_view(backlog));
+
+    for (auto _ : state) {
+        const auto n = buf.write(nova::data_view(chunk));
+        benchmark::DoNotOptimize(buf.view().ptr());
+        buf.consume(n);
+    }
+}
+
+/**
+ * Passes 16 MiB from a producer thread to the consumer (this) thread in
+ * chunks of the given size.
+ */
+template <typename Write, typename Receive>
+void between_threads(benchmark::State& state, Write write, Receive receive) {
+    constexpr std::size_t Total = 16 * 1024 * 1024;
+    const auto chunk = std::string(static_cast<std::size_t>(state.range(0)), 'a');
+
+    for (auto _ : state) {
+        auto producer = std::thread([&] {
+            for (std::size_t sent = 0; sent < Total; ) {
+                const auto n = write(nova::data_view(chunk.data(), std::min(chunk.size(), Total - sent)));
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                sent += n;
+            }
+        });
+        for (std::size_t received = 0; received < Total; ) {
+            const auto n = receive();
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+            received += n;
+        }
+        producer.join();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(Total));
+}
+
+} // namespace
+
+static void stream_buffer(benchmark::State& state) {
+    auto buf = nova::stream_buffer{ Capacity };
+    streaming(state, buf);
+}
+
+static void ring_buffer_mirrored(benchmark::State& state) {
+    auto buf = nova::ring_buffer{ Capacity };
+    streaming(state, buf);
+}
+
+static void ring_buffer_compacting(benchmark::State& state) {
+    auto buf = nova::ring_buffer{ Capacity, nova::ring_mapping::compacting };
+    streaming(state, buf);
+}
+
+static void threads_stream_buffer_mutex(benchmark::State& state) {
+    auto buf = nova::stream_buffer{ Capacity };
+    std::mutex mutex;
+
+    between_threads(
+        state,
+        [&](nova::data_view data) {
+            const auto lock = std::lock_guard(mutex);
+            return buf.write(data);
+        },
+        [&] {
+            const auto lock = std::lock_guard(mutex);
+            const auto n = buf.view().size();
+            buf.consume(n);
+            return n;
+        }
+    );
+}
+
+static void threads_spsc_ring_buffer(benchmark::State& state) {
+    auto buf = nova::spsc_ring_buffer{ Capacity };
+
+    between_threads(
+        state,
+        [&](nova::data_view data) { return buf.write(data); },
+        [&] {
+            const auto n = buf.view().size();
+            buf.consume(n);
+            return n;
+        }
+    );
+}
+
+BENCHMARK(stream_buffer)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(ring_buffer_mirrored)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(ring_buffer_compacting)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(threads_stream_buffer_mutex)->RangeMultiplier(8)->Range(64, 4096)->UseRealTime();
+BENCHMARK(threads_spsc_ring_buffer)->RangeMultiplier(8)->Range(64, 4096)->UseRealTime();
+
+BENCHMARK_MAIN();
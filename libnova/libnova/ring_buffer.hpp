@@ -0,0 +1,545 @@
+/**
+ * Part of Nova C++ Library.
+ *
+ * Fixed capacity byte ring buffer with the `stream_buffer` vocabulary.
+ *
+ * The storage is mapped twice into consecutive virtual memory (Linux), so the
+ * unread data and the free space are always contiguous, even when they wrap
+ * around the end of the buffer: nothing is ever moved.
+ *
+ * ```cpp
+ * auto buf = nova::ring_buffer{ 64 * 1024 };
+ *
+ * std::size_t n = buf.write(data);
+ * buf.view();      // contiguous, even if it wraps around
+ * buf.consume(n);
+ * ```
+ *
+ * Where mirroring is not available, the buffer falls back to shifting the
+ * unread data to the front when the free space at the end runs out, i.e.,
+ * the same as `stream_buffer`.
+ *
+ * `spsc_ring_buffer` is the same for passing a byte stream from one thread
+ * to another without locking:
+ *
+ * ```cpp
+ * auto buf = nova::spsc_ring_buffer{ 1024 * 1024 };
+ *
+ * // Producer thread                  // Consumer thread
+ * buf.write(data);                     auto data = buf.view();
+ *                                      buf.consume(parse(data));
+ * ```
+ */
+
+#pragma once
+
+#include <libnova/data.hpp>
+#include <libnova/error.hpp>
+#include <libnova/expected.hpp>
+#include <libnova/intrinsics.hpp>
+
+#ifdef NOVA_LINUX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace nova {
+
+namespace detail {
+
+    [[nodiscard]] inline auto page_size() -> std::size_t {
+#ifdef NOVA_LINUX
+        static const auto size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        return size;
+#else
+        return 4096;
+#endif
+    }
+
+    /**
+     * @brief   Memory of `size` bytes mapped twice, back to back.
+     *
+     * Byte `i` and `i + size` are the same byte for `i < size`.
+     */
+    class mirrored_memory {
+    public:
+        /**
+         * @param size  Must be a multiple of the page size.
+         */
+        [[nodiscard]] static auto create(std::size_t size) -> expected<mirrored_memory, error> {
+#ifdef NOVA_LINUX
+            const auto fd = memfd_create("nova-ring-buffer", MFD_CLOEXEC);
+            if (fd == -1) {
+                return { unexpect, "Cannot create memory file for mirroring" };
+            }
+
+            auto ret = map(fd, size);
+            close(fd);
+            return ret;
+#else
+            return { unexpect, fmt::format("Mirrored memory is not supported (size={})", size) };
+#endif
+        }
+
+        mirrored_memory() = default;
+
+        mirrored_memory(const mirrored_memory&) = delete;
+        mirrored_memory& operator=(const mirrored_memory&) = delete;
+
+        mirrored_memory(mirrored_memory&& other) noexcept
+            : m_data(std::exchange(other.m_data, nullptr))
+            , m_size(std::exchange(other.m_size, 0))
+        {}
+
+        mirrored_memory& operator=(mirrored_memory&& other) noexcept {
+            if (this != &other) {
+                release();
+                m_data = std::exchange(other.m_data, nullptr);
+                m_size = std::exchange(other.m_size, 0);
+            }
+            return *this;
+        }
+
+        ~mirrored_memory() {
+            release();
+        }
+
+        [[nodiscard]] auto data() const -> std::byte* { return m_data; }
+        [[nodiscard]] auto size() const -> std::size_t { return m_size; }
+
+    private:
+        std::byte* m_data = nullptr;
+        std::size_t m_size = 0;
+
+        mirrored_memory(std::byte* data, std::size_t size)
+            : m_data(data)
+            , m_size(size)
+        {}
+
+#ifdef NOVA_LINUX
+        [[nodiscard]] static auto map(int fd, std::size_t size) -> expected<mirrored_memory, error> {
+            if (ftruncate(fd, static_cast<off_t>(size)) == -1) {
+                return { unexpect, fmt::format("Cannot resize memory file to {} bytes", size) };
+            }
+
+            // Reserve the address range for both copies, then map the file over it twice.
+            auto* addr = mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (addr == MAP_FAILED) {
+                return { unexpect, fmt::format("Cannot reserve {} bytes of address space", 2 * size) };
+            }
+
+            auto* ptr = static_cast<std::byte*>(addr);
+            auto* mirror = std::next(ptr, static_cast<std::ptrdiff_t>(size));
+
+            if (mmap(ptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+                or mmap(mirror, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+                munmap(addr, 2 * size);
+                return { unexpect, "Cannot map memory file twice" };
+            }
+
+            return mirrored_memory{ ptr, size };
+        }
+#endif
+
+        void release() {
+#ifdef NOVA_LINUX
+            if (m_data != nullptr) {
+                munmap(m_data, 2 * m_size);
+            }
+#endif
+            m_data = nullptr;
+            m_size = 0;
+        }
+    };
+
+} // namespace detail
+
+/**
+ * @brief   How the ring buffer keeps its unread data contiguous.
+ */
+enum class ring_mapping : std::uint8_t {
+    mirrored,               // Double-mapped memory; nothing is moved.
+    compacting,             // Unread data is moved to the front when needed.
+};
+
+/**
+ * @brief   Byte ring buffer of fixed capacity.
+ *
+ * Both the unread data (`view()`) and the free space (`free_space()`) are
+ * contiguous in memory at all times. The capacity is rounded up to a multiple
+ * of the page size.
+ *
+ * NOTE: views are invalidated by `write()` and `commit()` in the compacting
+ * mode only, otherwise just by consuming the data.
+ */
+class ring_buffer {
+public:
+    /**
+     * @brief   Allocates a buffer of at least `capacity` bytes.
+     *
+     * Requesting the mirrored mapping falls back to compacting if mirroring
+     * is not available; see `mapping()`.
+     */
+    [[nodiscard]] explicit ring_buffer(std::size_t capacity, ring_mapping mapping = ring_mapping::mirrored)
+        : m_capacity(round_up(std::max(capacity, std::size_t{ 1 })))
+    {
+        if (mapping == ring_mapping::mirrored) {
+            if (auto memory = detail::mirrored_memory::create(m_capacity); memory.has_value()) {
+                m_mirror = std::move(*memory);
+                m_base = m_mirror.data();
+                return;
+            }
+        }
+        m_fallback.resize(m_capacity);
+        m_base = m_fallback.data();
+    }
+
+    [[nodiscard]] auto mapping() const -> ring_mapping {
+        return m_mirror.data() != nullptr ? ring_mapping::mirrored : ring_mapping::compacting;
+    }
+
+    [[nodiscard]] auto capacity() const -> std::size_t { return m_capacity; }
+    [[nodiscard]] auto size()     const -> std::size_t { return m_size; }
+    [[nodiscard]] auto empty()    const -> bool        { return m_size == 0; }
+    [[nodiscard]] auto full()     const -> bool        { return m_size == m_capacity; }
+
+    /**
+     * @brief   The unread data.
+     */
+    [[nodiscard]] auto view() const -> data_view {
+        return { std::next(m_base, offset(m_read)), m_size };
+    }
+
+    /**
+     * @brief   Contiguous free space after the unread data, to be filled directly
+     *          (e.g., by `read(2)`) and then published with `commit()`.
+     *
+     * In the compacting mode it is only the free space at the end of the
+     * buffer, unless it is exhausted.
+     */
+    [[nodiscard]] auto free_space() -> std::span<std::byte> {
+        return reserve(1);
+    }
+
+    /**
+     * @brief   Publish `n` bytes written into `free_space()`.
+     */
+    void commit(std::size_t n) {
+        nova_assert(n <= m_capacity - m_size);
+        m_size += n;
+    }
+
+    /**
+     * @brief   Write data from view into the buffer.
+     *
+     * @returns with the number of bytes written into the buffer.
+     */
+    [[nodiscard]] auto write(data_view data) -> std::size_t {
+        const auto space = reserve(data.size());
+        const auto n = std::min(data.size(), space.size());
+        if (n > 0) {
+            std::memcpy(space.data(), data.ptr(), n);
+            m_size += n;
+        }
+        return n;
+    }
+
+#ifdef NOVA_LINUX
+    /**
+     * @brief   Read from a file descriptor directly into the free space with
+     *          a single `readv` call. It reads nothing if the buffer is full.
+     *
+     * @returns the number of bytes read, and whether the descriptor would
+     *          block or reached its end; an error for other failures.
+     */
+    [[nodiscard]] auto fill_from(int fd) -> expected<io_result, error> {
+        const auto space = free_space();
+        if (space.empty()) {
+            return io_result{ };
+        }
+
+        const auto iov = iovec{ space.data(), space.size() };
+        auto result = detail::read_fd(fd, std::span(&iov, 1));
+        if (result.has_value()) {
+            commit(result->bytes);
+        }
+        return result;
+    }
+
+    /**
+     * @brief   Write the unread data into a file descriptor with `writev`,
+     *          consuming what is written.
+     *
+     * Partial writes are continued until the buffer is empty or the
+     * descriptor would block.
+     */
+    [[nodiscard]] auto drain_to(int fd) -> expected<io_result, error> {
+        return detail::drain_buffer(*this, fd);
+    }
+#endif
+
+    /**
+     * @brief   Consume everything, effectively clearing the buffer.
+     */
+    void consume() {
+        consume(m_size);
+    }
+
+    /**
+     * @brief   Consume some number of bytes from the buffer.
+     */
+    void consume(std::size_t n) {
+        n = std::min(n, m_size);
+        m_size -= n;
+        m_read = m_size == 0 ? 0 : (m_read + n) % m_capacity;
+    }
+
+private:
+    detail::mirrored_memory m_mirror;
+    std::vector<std::byte> m_fallback;
+    std::byte* m_base = nullptr;
+    std::size_t m_capacity;
+
+    /**
+     * Position of the first unread byte, always less than the capacity.
+     */
+    std::size_t m_read = 0;
+    std::size_t m_size = 0;
+
+    [[nodiscard]] static auto round_up(std::size_t n) -> std::size_t {
+        const auto page = detail::page_size();
+        return (n + page - 1) / page * page;
+    }
+
+    [[nodiscard]] static auto offset(std::size_t pos) -> std::ptrdiff_t {
+        return static_cast<std::ptrdiff_t>(pos);
+    }
+
+    /**
+     * @brief   Free space after the unread data. In the compacting mode the
+     *          unread data is moved to the front if there is less than `n`
+     *          bytes free at the end.
+     */
+    [[nodiscard]] auto reserve(std::size_t n) -> std::span<std::byte> {
+        if (mapping() == ring_mapping::compacting) {
+            if (m_read > 0 and m_capacity - m_read - m_size < n) {
+                std::memmove(m_base, std::next(m_base, offset(m_read)), m_size);
+                m_read = 0;
+            }
+            return { std::next(m_base, offset(m_read + m_size)), m_capacity - m_read - m_size };
+        }
+        return { std::next(m_base, offset(m_read + m_size)), m_capacity - m_size };
+    }
+
+};
+
+/**
+ * @brief   Lock-free byte ring buffer for a single producer and a single consumer thread.
+ *
+ * The producer calls `free_space()`, `commit()`, `publish()`, `stage()` and
+ * `write()`; the consumer calls `view()` and `consume()`. Only acquire/release
+ * operations are used, and the positions owned by each side are on separate
+ * cache lines.
+ *
+ * Written data becomes visible to the consumer when it is published, so many
+ * small writes can be batched into a single publication with `stage()`.
+ *
+ * With mirrored memory, `view()` is all the published data and `free_space()`
+ * is all the free space. Without it, both end at the end of the buffer, and
+ * the rest is available after the first part is consumed or committed.
+ */
+class spsc_ring_buffer {
+public:
+    static constexpr std::size_t CacheLineSize = 64;
+
+    /**
+     * @brief   Allocates a buffer of at least `capacity` bytes, rounded up to
+     *          a power of two multiple of the page size.
+     */
+    [[nodiscard]] explicit spsc_ring_buffer(std::size_t capacity)
+        : m_capacity(std::bit_ceil(std::max(capacity, detail::page_size())))
+    {
+        if (auto memory = detail::mirrored_memory::create(m_capacity); memory.has_value()) {
+            m_mirror = std::move(*memory);
+            m_base = m_mirror.data();
+        }
+        else {
+            m_fallback.resize(m_capacity);
+            m_base = m_fallback.data();
+        }
+    }
+
+    spsc_ring_buffer(const spsc_ring_buffer&) = delete;
+    spsc_ring_buffer& operator=(const spsc_ring_buffer&) = delete;
+    spsc_ring_buffer(spsc_ring_buffer&&) = delete;
+    spsc_ring_buffer& operator=(spsc_ring_buffer&&) = delete;
+    ~spsc_ring_buffer() = default;
+
+    [[nodiscard]] auto capacity() const -> std::size_t { return m_capacity; }
+    [[nodiscard]] auto mirrored() const -> bool        { return m_mirror.data() != nullptr; }
+
+    /**
+     * @brief   Number of published and unread bytes; exact only if the other
+     *          thread is idle.
+     */
+    [[nodiscard]] auto size() const -> std::size_t {
+        const auto read = m_read.load(std::memory_order_acquire);
+        return m_write.load(std::memory_order_acquire) - read;
+    }
+
+    [[nodiscard]] auto empty() const -> bool { return size() == 0; }
+
+    // Producer
+
+    /**
+     * @brief   Contiguous free space after the committed data, to be filled
+     *          directly and then committed with `commit()`.
+     */
+    [[nodiscard]] auto free_space() -> std::span<std::byte> {
+        return free_space(m_capacity);
+    }
+
+    /**
+     * @brief   Same as `free_space()`, but the consumer's position is loaded
+     *          only if less than `wanted` bytes are known to be free, so small
+     *          writes do not touch the consumer's cache line every time.
+     */
+    [[nodiscard]] auto free_space(std::size_t wanted) -> std::span<std::byte> {
+        auto& p = m_producer;
+        if (m_capacity - (p.committed - p.read_cache) < wanted) {
+            p.read_cache = m_read.load(std::memory_order_acquire);
+        }
+        const auto free = m_capacity - (p.committed - p.read_cache);
+        const auto pos = index(p.committed);
+        return { std::next(m_base, offset(pos)), mirrored() ? free : std::min(free, m_capacity - pos) };
+    }
+
+    /**
+     * @brief   Mark `n` bytes written into `free_space()` as committed, without
+     *          publishing them.
+     */
+    void commit(std::size_t n) {
+        nova_assert(n <= m_capacity - (m_producer.committed - m_producer.read_cache));
+        m_producer.committed += n;
+    }
+
+    /**
+     * @brief   Make all the committed data visible to the consumer.
+     */
+    void publish() {
+        m_write.store(m_producer.committed, std::memory_order_release);
+    }
+
+    /**
+     * @brief   Copy data into the buffer without publishing it.
+     *
+     * @returns with the number of bytes written into the buffer.
+     */
+    [[nodiscard]] auto stage(data_view data) -> std::size_t {
+        std::size_t written = 0;
+        while (written < data.size()) {
+            const auto space = free_space(data.size() - written);
+            const auto n = std::min(data.size() - written, space.size());
+            if (n == 0) {
+                break;
+            }
+            std::memcpy(space.data(), std::next(data.ptr(), offset(written)), n);
+            commit(n);
+            written += n;
+        }
+        return written;
+    }
+
+    /**
+     * @brief   Write data from view into the buffer, and publish it together
+     *          with the data staged before.
+     *
+     * @returns with the number of bytes written into the buffer.
+     */
+    [[nodiscard]] auto write(data_view data) -> std::size_t {
+        const auto n = stage(data);
+        publish();
+        return n;
+    }
+
+    // Consumer
+
+    /**
+     * @brief   The published, unread data.
+     */
+    [[nodiscard]] auto view() -> data_view {
+        auto& c = m_consumer;
+        c.write_cache = m_write.load(std::memory_order_acquire);
+        const auto size = c.write_cache - c.read;
+        const auto pos = index(c.read);
+        return { std::next(m_base, offset(pos)), mirrored() ? size : std::min(size, m_capacity - pos) };
+    }
+
+    /**
+     * @brief   Consume the data returned by the last `view()`; data published
+     *          after it is kept.
+     */
+    void consume() {
+        const auto& c = m_consumer;
+        const auto size = c.write_cache - c.read;
+        consume(mirrored() ? size : std::min(size, m_capacity - index(c.read)));
+    }
+
+    /**
+     * @brief   Consume some number of bytes, releasing their space for the producer.
+     */
+    void consume(std::size_t n) {
+        auto& c = m_consumer;
+        if (c.write_cache - c.read < n) {
+            c.write_cache = m_write.load(std::memory_order_acquire);
+        }
+        c.read += std::min(n, c.write_cache - c.read);
+        m_read.store(c.read, std::memory_order_release);
+    }
+
+private:
+    struct alignas(CacheLineSize) producer_state {
+        std::size_t committed = 0;
+        std::size_t read_cache = 0;
+    };
+
+    struct alignas(CacheLineSize) consumer_state {
+        std::size_t read = 0;
+        std::size_t write_cache = 0;
+    };
+
+    detail::mirrored_memory m_mirror;
+    std::vector<std::byte> m_fallback;
+    std::byte* m_base = nullptr;
+    std::size_t m_capacity;
+
+    /**
+     * Positions grow monotonically (wrapping at 2^64); the index is the position
+     * modulo the capacity.
+     */
+    alignas(CacheLineSize) std::atomic<std::size_t> m_write = 0;
+    alignas(CacheLineSize) std::atomic<std::size_t> m_read = 0;
+    producer_state m_producer;
+    consumer_state m_consumer;
+
+    [[nodiscard]] auto index(std::size_t pos) const -> std::size_t {
+        return pos & (m_capacity - 1);
+    }
+
+    [[nodiscard]] static auto offset(std::size_t pos) -> std::ptrdiff_t {
+        return static_cast<std::ptrdiff_t>(pos);
+    }
+
+};
+
+} // namespace nova
@@ -0,0 +1,279 @@
+#define NOVA_RUNTIME_ASSERTIONS
+
+#include <libnova/data.hpp>
+#include <libnova/ring_buffer.hpp>
+#include <libnova/test_utils.hpp>
+
+#include <gtest/gtest.h>
+
+#ifdef NOVA_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+using namespace nova::literals;
+
+template <typename T>
+class RingBuffer : public testing::Test {
+protected:
+    static constexpr auto Mapping = T::value;
+};
+
+using Mappings = testing::Types<
+    std::integral_constant<nova::ring_mapping, nova::ring_mapping::mirrored>,
+    std::integral_constant<nova::ring_mapping, nova::ring_mapping::compacting>
+>;
+TYPED_TEST_SUITE(RingBuffer, Mappings);
+
+TYPED_TEST(RingBuffer, Capacity) {
+    auto buf = nova::ring_buffer{ 100, TestFixture::Mapping };
+    EXPECT_EQ(buf.mapping(), TestFixture::Mapping);
+    EXPECT_EQ(buf.capacity() % nova::detail::page_size(), 0);
+    EXPECT_GE(buf.capacity(), 100);
+    EXPECT_TRUE(buf.empty());
+}
+
+TYPED_TEST(RingBuffer, WriteConsume) {
+    auto buf = nova::ring_buffer{ 1, TestFixture::Mapping };
+    EXPECT_EQ(buf.write("Hello Nova"_data), 10);
+    EXPECT_EQ(buf.view().as_string(), "Hello Nova");
+
+    buf.consume(6);
+    EXPECT_EQ(buf.size(), 4);
+    EXPECT_EQ(buf.view().as_string(), "Nova");
+
+    buf.consume(10);
+    EXPECT_TRUE(buf.empty());
+}
+
+TYPED_TEST(RingBuffer, WriteToFull) {
+    auto buf = nova::ring_buffer{ 1, TestFixture::Mapping };
+    const auto data = std::string(buf.capacity() - 2, 'a');
+
+    EXPECT_EQ(buf.write(nova::data_view(data)), data.size());
+    EXPECT_EQ(buf.write("bcd"_data), 2);
+    EXPECT_TRUE(buf.full());
+    EXPECT_EQ(buf.write("d"_data), 0);
+    EXPECT_TRUE(buf.free_space().empty());
+
+    buf.consume(1);
+    EXPECT_EQ(buf.write("d"_data), 1);
+    EXPECT_EQ(buf.view().as_string().substr(buf.size() - 3), "bcd");
+}
+
+TYPED_TEST(RingBuffer, WrapAround) {
+    auto buf = nova::ring_buffer{ 1, TestFixture::Mapping };
+    const auto chunk = std::string(buf.capacity() / 3 + 1, 'x');
+
+    for (std::size_t i = 0; i < 10; ++i) {
+        std::string expected = fmt::format("{:03}", i) + chunk;
+        ASSERT_EQ(buf.write(nova::data_view(expected)), expected.size());
+        ASSERT_EQ(buf.view().as_string(), expected);
+        buf.consume();
+    }
+
+    // Keep data across the end of the buffer
+    EXPECT_EQ(buf.write(nova::data_view(chunk)), chunk.size());
+    EXPECT_EQ(buf.write(nova::data_view(chunk)), chunk.size());
+    buf.consume(chunk.size());
+    EXPECT_EQ(buf.write(nova::data_view(chunk)), chunk.size());
+    EXPECT_EQ(buf.write("end"_data), 3);
+    EXPECT_EQ(buf.view().as_string(), chunk + chunk + "end");
+}
+
+TYPED_TEST(RingBuffer, FreeSpaceCommit) {
+    auto buf = nova::ring_buffer{ 1, TestFixture::Mapping };
+    EXPECT_EQ(buf.write("abc"_data), 3);
+
+    auto space = buf.free_space();
+    EXPECT_EQ(space.size(), buf.capacity() - 3);
+    std::memcpy(space.data(), "def", 3);
+    buf.commit(3);
+    EXPECT_EQ(buf.view().as_string(), "abcdef");
+
+    EXPECT_ASSERTION_FAIL(buf.commit(buf.capacity()));
+}
+
+TEST(RingBuffer, MirroredNeverMovesData) {
+    auto buf = nova::ring_buffer{ 1 };
+    ASSERT_EQ(buf.mapping(), nova::ring_mapping::mirrored);
+    const auto* base = buf.view().ptr();
+    const auto half = std::string(buf.capacity() / 2 + 1, 'a');
+
+    EXPECT_EQ(buf.write(nova::data_view(half)), half.size());
+    buf.consume(half.size() - 1);
+    EXPECT_EQ(buf.write(nova::data_view(half)), half.size());
+
+    // The unread data continues in the mirror past the end of the buffer.
+    EXPECT_EQ(buf.view().ptr(), base + half.size() - 1);
+    EXPECT_EQ(buf.view().as_string(), "a" + half);
+}
+
+TEST(SpscRingBuffer, WriteConsume) {
+    auto buf = nova::spsc_ring_buffer{ 100 };
+    EXPECT_EQ(buf.capacity(), nova::detail::page_size());
+    EXPECT_TRUE(buf.empty());
+
+    EXPECT_EQ(buf.write("Hello Nova"_data), 10);
+    EXPECT_EQ(buf.size(), 10);
+    EXPECT_EQ(buf.view().as_string(), "Hello Nova");
+
+    buf.consume(6);
+    EXPECT_EQ(buf.view().as_string(), "Nova");
+    buf.consume();
+    EXPECT_TRUE(buf.empty());
+    EXPECT_TRUE(buf.view().empty());
+}
+
+TEST(SpscRingBuffer, ConsumeKeepsDataPublishedAfterView) {
+    auto buf = nova::spsc_ring_buffer{ 1 };
+    EXPECT_EQ(buf.write("A"_data), 1);
+    EXPECT_EQ(buf.view().as_string(), "A");
+
+    EXPECT_EQ(buf.write("B"_data), 1);
+    buf.consume();
+    EXPECT_EQ(buf.size(), 1);
+    EXPECT_EQ(buf.view().as_string(), "B");
+    buf.consume();
+    EXPECT_TRUE(buf.empty());
+}
+
+TEST(SpscRingBuffer, BatchPublication) {
+    auto buf = nova::spsc_ring_buffer{ 1 };
+    EXPECT_EQ(buf.stage("Hello"_data), 5);
+    EXPECT_EQ(buf.stage(" "_data), 1);
+    EXPECT_TRUE(buf.view().empty());
+
+    buf.consume(3);
+    EXPECT_TRUE(buf.view().empty());
+
+    EXPECT_EQ(buf.write("Nova"_data), 4);
+    EXPECT_EQ(buf.view().as_string(), "Hello Nova");
+
+    auto space = buf.free_space();
+    EXPECT_EQ(space.size(), buf.capacity() - 10);
+    std::memcpy(space.data(), "!", 1);
+    buf.commit(1);
+    EXPECT_EQ(buf.view().as_string(), "Hello Nova");
+    buf.publish();
+    EXPECT_EQ(buf.view().as_string(), "Hello Nova!");
+
+    EXPECT_ASSERTION_FAIL(buf.commit(buf.capacity()));
+}
+
+TEST(SpscRingBuffer, WriteToFullAndWrapAround) {
+    auto buf = nova::spsc_ring_buffer{ 1 };
+    const auto data = std::string(buf.capacity() - 2, 'a');
+
+    EXPECT_EQ(buf.write(nova::data_view(data)), data.size());
+    EXPECT_EQ(buf.write("bcd"_data), 2);
+    EXPECT_TRUE(buf.free_space().empty());
+    EXPECT_EQ(buf.write("d"_data), 0);
+
+    buf.consume(buf.capacity() - 1);
+    EXPECT_EQ(buf.write("def"_data), 3);
+
+    std::string received;
+    while (not buf.empty()) {
+        const auto view = buf.view();
+        received += view.as_string();
+        buf.consume(view.size());
+    }
+    EXPECT_EQ(received, "cdef");
+}
+
+TEST(SpscRingBuffer, FreeSpaceAfterConsumed) {
+    auto buf = nova::spsc_ring_buffer{ 1 };
+    const auto capacity = buf.capacity();
+
+    EXPECT_EQ(buf.write(nova::data_view(std::string(capacity - 10, 'a'))), capacity - 10);
+    buf.consume(capacity - 10);
+    EXPECT_EQ(buf.write(nova::data_view(std::string(20, 'b'))), 20);
+    buf.consume(20);
+
+    // All the space is free, not only what was free at the last write
+    EXPECT_EQ(buf.free_space().size(), buf.mirrored() ? capacity : capacity - 10);
+    EXPECT_EQ(buf.free_space(1).size(), buf.mirrored() ? capacity : capacity - 10);
+}
+
+TEST(SpscRingBuffer, BetweenThreads) {
+    constexpr std::size_t Total = 10'000'000;
+    auto buf = nova::spsc_ring_buffer{ 1 };
+
+    auto producer = std::thread([&buf] {
+        auto chunk = std::array<std::uint8_t, 97>{ };
+        std::size_t sent = 0;
+        while (sent < Total) {
+            const auto length = std::min(chunk.size(), Total - sent);
+            for (std::size_t i = 0; i < length; ++i) {
+                chunk[i] = static_cast<std::uint8_t>((sent + i) % 251);
+            }
+            const auto n = buf.write(nova::data_view(chunk.data(), length));
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+            sent += n;
+        }
+    });
+
+    std::size_t received = 0;
+    std::size_t errors = 0;
+    while (received < Total) {
+        const auto view = buf.view();
+        if (view.empty()) {
+            std::this_thread::yield();
+        }
+        for (std::size_t i = 0; i < view.size(); ++i) {
+            if (view.as_number<std::uint8_t>(i) != (received + i) % 251) {
+                ++errors;
+            }
+        }
+        received += view.size();
+        buf.consume(view.size());
+    }
+    producer.join();
+
+    EXPECT_EQ(received, Total);
+    EXPECT_EQ(errors, 0);
+    EXPECT_TRUE(buf.empty());
+}
+
+#ifdef NOVA_LINUX
+
+TYPED_TEST(RingBuffer, FillFromDrainTo) {
+    auto fds = pipe_fds{ O_NONBLOCK };
+
+    auto out = nova::ring_buffer{ 1, TestFixture::Mapping };
+    auto in = nova::ring_buffer{ 1, TestFixture::Mapping };
+    const auto chunk = std::string(out.capacity() / 3 + 1, 'x');
+    std::string received;
+
+    for (std::size_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(out.write(nova::data_view(chunk)), chunk.size());
+        const auto sent = out.drain_to(fds.write);
+        ASSERT_TRUE(sent.has_value());
+        EXPECT_EQ(sent->bytes, chunk.size());
+        EXPECT_TRUE(out.empty());
+
+        const auto result = in.fill_from(fds.read);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->bytes, chunk.size());
+        received += in.view().as_string();
+        in.consume();
+    }
+    EXPECT_EQ(received.size(), 10 * chunk.size());
+
+    EXPECT_EQ(in.fill_from(fds.read)->status, nova::io_status::would_block);
+    fds.close_write();
+    EXPECT_EQ(in.fill_from(fds.read)->status, nova::io_status::eof);
+}
+
+#endif // NOVA_LINUX
@@ -0,0 +1,379 @@
+/**
+ * Part of Nova C++ Library.
+ *
+ * Byte buffer made of a chain of fixed size segments.
+ *
+ * Unlike `stream_buffer`, it is not limited by the `int` based size of
+ * `std::basic_streambuf`, and it never copies the data it holds: growing
+ * appends a new segment, and consuming releases the segments that are read.
+ * Released segments are kept in a `segment_pool` for reuse.
+ *
+ * It has the same vocabulary as `stream_buffer`, where `view()` is the
+ * unread part of the first segment, so the usual loop works unchanged:
+ *
+ * ```cpp
+ * auto buf = nova::segmented_buffer{ 4ULL << 30U };                   // 4 GiB
+ * buf.write(data);
+ *
+ * while (not buf.empty()) {
+ *     auto data = buf.view();
+ *     auto n = send(socket, data.ptr(), data.size());
+ *     buf.consume(n);
+ * }
+ * ```
+ *
+ * All the unread data can be accessed with `segments()`, or as `iovec`s for
+ * scatter/gather I/O (Linux).
+ */
+
+#pragma once
+
+#include <libnova/data.hpp>
+#include <libnova/error.hpp>
+#include <libnova/expected.hpp>
+#include <libnova/intrinsics.hpp>
+
+#ifdef NOVA_LINUX
+#include <sys/uio.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace nova {
+
+/**
+ * @brief   Recycles fixed size segments for `segmented_buffer`s.
+ *
+ * NOTE: it is not thread-safe; share it only between buffers used by the same
+ * thread.
+ */
+class segment_pool {
+public:
+    using segment = std::vector<std::byte>;
+
+    static constexpr std::size_t DefaultSegmentSize = 16 * 1024;
+
+    [[nodiscard]] explicit segment_pool(std::size_t segment_size = DefaultSegmentSize)
+        : m_segment_size(std::max(segment_size, std::size_t{ 1 }))
+    {}
+
+    [[nodiscard]] auto segment_size() const -> std::size_t { return m_segment_size; }
+
+    /**
+     * @brief   Number of segments available for reuse.
+     */
+    [[nodiscard]] auto cached() const -> std::size_t { return m_free.size(); }
+
+    /**
+     * @brief   Take a segment from the pool, or allocate one if it is empty.
+     */
+    [[nodiscard]] auto acquire() -> segment {
+        if (m_free.empty()) {
+            return segment(m_segment_size);
+        }
+        auto ret = std::move(m_free.back());
+        m_free.pop_back();
+        return ret;
+    }
+
+    /**
+     * @brief   Give back a segment for reuse.
+     */
+    void release(segment&& x) {
+        nova_assert(x.size() == m_segment_size);
+        m_free.push_back(std::move(x));
+    }
+
+private:
+    std::size_t m_segment_size;
+    std::vector<segment> m_free;
+};
+
+/**
+ * @brief   Byte buffer of chained fixed size segments with 64-bit sizes.
+ *
+ * Appending and consuming are O(1) per segment; data is never moved.
+ */
+class segmented_buffer {
+    static constexpr std::size_t FillSize = 64 * 1024;
+    static constexpr std::size_t MaxIoSegments = 64;
+
+public:
+    /**
+     * @param max_size  Maximum number of unread bytes.
+     * @param pool      Source of the segments, it can be shared between buffers.
+     */
+    [[nodiscard]] explicit segmented_buffer(
+        std::uint64_t max_size,
+        std::shared_ptr<segment_pool> pool = std::make_shared<segment_pool>()
+    )
+        : m_pool(std::move(pool))
+        , m_max_size(max_size)
+        , m_tail(m_pool->segment_size())
+    {}
+
+    segmented_buffer(const segmented_buffer&) = delete;
+    segmented_buffer& operator=(const segmented_buffer&) = delete;
+    segmented_buffer(segmented_buffer&&) noexcept = default;
+    segmented_buffer& operator=(segmented_buffer&&) noexcept = default;
+
+    ~segmented_buffer() {
+        if (m_pool != nullptr) {
+            while (not m_segments.empty()) {
+                release_front();
+            }
+        }
+    }
+
+    [[nodiscard]] auto size()     const -> std::uint64_t { return m_size; }
+    [[nodiscard]] auto max_size() const -> std::uint64_t { return m_max_size; }
+    [[nodiscard]] auto empty()    const -> bool          { return m_size == 0; }
+
+    [[nodiscard]] auto pool() const -> const std::shared_ptr<segment_pool>& { return m_pool; }
+
+    /**
+     * @brief   Number of segments holding unread data or free space.
+     */
+    [[nodiscard]] auto segment_count() const -> std::size_t { return m_segments.size(); }
+
+    /**
+     * @brief   Unread data in the first segment.
+     */
+    [[nodiscard]] auto view() const -> data_view {
+        if (m_segments.empty()) {
+            return { nullptr, 0 };
+        }
+        return segment_view(0);
+    }
+
+    /**
+     * @brief   All the unread data as a range of `data_view`s, one per segment.
+     */
+    [[nodiscard]] auto segments() const {
+        return std::views::iota(std::size_t{ 0 }, m_segments.size())
+             | std::views::transform([this](std::size_t i) { return segment_view(i); });
+    }
+
+    /**
+     * @brief   Write data from view into the buffer.
+     *
+     * @returns with the number of bytes written into the buffer, which is
+     *          less than the size of `data` only if the maximum size is reached.
+     */
+    [[nodiscard]] auto write(data_view data) -> std::uint64_t {
+        const auto segment_size = m_pool->segment_size();
+        const auto n = std::min<std::uint64_t>(data.size(), m_max_size - m_size);
+
+        for (std::uint64_t written = 0; written < n; ) {
+            if (m_tail == segment_size) {
+                m_segments.push_back(m_pool->acquire());
+                m_tail = 0;
+            }
+            const auto length = std::min<std::uint64_t>(segment_size - m_tail, n - written);
+            std::memcpy(at(m_segments.back(), m_tail), at(data, written), length);
+            m_tail += length;
+            written += length;
+        }
+
+        m_size += n;
+        return n;
+    }
+
+    /**
+     * @brief   Consume everything, effectively clearing the buffer.
+     */
+    void consume() {
+        consume(m_size);
+    }
+
+    /**
+     * @brief   Consume some number of bytes from the buffer.
+     *
+     * Fully read segments are given back to the pool, except for the last one.
+     */
+    void consume(std::uint64_t n) {
+        n = std::min(n, m_size);
+        m_size -= n;
+
+        while (n > 0) {
+            const auto length = std::min<std::uint64_t>(n, segment_end(0) - m_head);
+            m_head += length;
+            n -= length;
+
+            if (m_head == segment_end(0) and m_segments.size() > 1) {
+                release_front();
+            }
+        }
+
+        if (m_size == 0 and not m_segments.empty()) {
+            m_head = 0;
+            m_tail = 0;
+        }
+    }
+
+#ifdef NOVA_LINUX
+    /**
+     * @brief   Fill `out` with the unread data of the first segments.
+     *
+     * @returns the number of `iovec`s filled.
+     */
+    [[nodiscard]] auto iovecs(std::span<iovec> out) const -> std::size_t {
+        const auto count = std::min(out.size(), m_size == 0 ? std::size_t{ 0 } : m_segments.size());
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto data = segment_view(i);
+            out[i] = iovec{ const_cast<std::byte*>(data.ptr()), data.size() };                   // NOLINT(cppcoreguidelines-pro-type-const-cast) | `iovec` is used for writing from the buffer
+        }
+        return count;
+    }
+
+    /**
+     * @brief   Read from a file descriptor with a single `readv` call into the
+     *          free space of the last segment and up to 64 KiB of new segments.
+     *
+     * Unused new segments are given back to the pool.
+     *
+     * @returns the number of bytes read, and whether the descriptor would
+     *          block or reached its end; an error for other failures.
+     */
+    [[nodiscard]] auto fill_from(int fd) -> expected<io_result, error> {
+        const auto segment_size = m_pool->segment_size();
+        auto budget = m_max_size - m_size;
+        if (budget == 0) {
+            return io_result{ };
+        }
+
+        auto iov = std::array<iovec, MaxIoSegments>{ };
+        std::size_t count = 0;
+        std::size_t tail_space = 0;
+
+        if (m_tail < segment_size) {
+            tail_space = static_cast<std::size_t>(std::min<std::uint64_t>(segment_size - m_tail, budget));
+            iov[count++] = iovec{ at(m_segments.back(), m_tail), tail_space };
+            budget -= tail_space;
+        }
+
+        const auto old_segments = m_segments.size();
+        for (std::size_t fresh = 0; budget > 0 and fresh < FillSize and count < iov.size(); fresh += segment_size) {
+            m_segments.push_back(m_pool->acquire());
+            const auto length = static_cast<std::size_t>(std::min<std::uint64_t>(segment_size, budget));
+            iov[count++] = iovec{ m_segments.back().data(), length };
+            budget -= length;
+        }
+
+        auto result = detail::read_fd(fd, std::span(iov.data(), count));
+        const auto n = result.has_value() ? result->bytes : 0;
+        m_size += n;
+
+        // The free space of the last segment is filled first, then the new ones in order.
+        const auto rest = n - std::min(n, tail_space);
+        const auto used = (rest + segment_size - 1) / segment_size;
+        while (m_segments.size() > old_segments + used) {
+            m_pool->release(std::move(m_segments.back()));
+            m_segments.pop_back();
+        }
+        if (used > 0) {
+            m_tail = rest - (used - 1) * segment_size;
+        }
+        else if (tail_space > 0) {
+            m_tail += n;
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief   Write the unread data into a file descriptor with `writev`,
+     *          consuming what is written.
+     *
+     * Partial writes are continued until the buffer is empty or the
+     * descriptor would block.
+     *
+     * @returns the number of bytes written, and whether the descriptor would
+     *          block; an error for other failures (the bytes written before
+     *          are consumed).
+     */
+    [[nodiscard]] auto drain_to(int fd) -> expected<io_result, error> {
+        auto ret = io_result{ };
+        auto iov = std::array<iovec, MaxIoSegments>{ };
+
+        while (not empty()) {
+            const auto count = iovecs(iov);
+            const auto result = detail::write_fd(fd, std::span(iov.data(), count));
+            if (not result.has_value()) {
+                return result;
+            }
+
+            consume(result->bytes);
+            ret.bytes += result->bytes;
+            if (result->status != io_status::ok) {
+                ret.status = result->status;
+                break;
+            }
+        }
+        return ret;
+    }
+#endif
+
+private:
+    std::shared_ptr<segment_pool> m_pool;
+    std::deque<segment_pool::segment> m_segments;
+    std::uint64_t m_max_size;
+    std::uint64_t m_size = 0;
+
+    /**
+     * Position of the first unread byte in the first segment.
+     */
+    std::size_t m_head = 0;
+
+    /**
+     * End of the data in the last segment; the segment size if there is none.
+     */
+    std::size_t m_tail;
+
+    [[nodiscard]] static auto at(segment_pool::segment& x, std::uint64_t pos) -> std::byte* {
+        return std::next(x.data(), static_cast<std::ptrdiff_t>(pos));
+    }
+
+    [[nodiscard]] static auto at(const segment_pool::segment& x, std::uint64_t pos) -> const std::byte* {
+        return std::next(x.data(), static_cast<std::ptrdiff_t>(pos));
+    }
+
+    [[nodiscard]] static auto at(data_view x, std::uint64_t pos) -> const std::byte* {
+        return std::next(x.ptr(), static_cast<std::ptrdiff_t>(pos));
+    }
+
+    [[nodiscard]] auto segment_begin(std::size_t i) const -> std::size_t {
+        return i == 0 ? m_head : 0;
+    }
+
+    [[nodiscard]] auto segment_end(std::size_t i) const -> std::size_t {
+        return i + 1 == m_segments.size() ? m_tail : m_pool->segment_size();
+    }
+
+    [[nodiscard]] auto segment_view(std::size_t i) const -> data_view {
+        const auto begin = segment_begin(i);
+        return { at(m_segments[i], begin), segment_end(i) - begin };
+    }
+
+    void release_front() {
+        m_pool->release(std::move(m_segments.front()));
+        m_segments.pop_front();
+        m_head = 0;
+        if (m_segments.empty()) {
+            m_tail = m_pool->segment_size();
+        }
+    }
+
+};
+
+} // namespace nova
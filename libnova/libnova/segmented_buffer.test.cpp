@@ -0,0 +1,186 @@
+#define NOVA_RUNTIME_ASSERTIONS
+
+#include <libnova/data.hpp>
+#include <libnova/segmented_buffer.hpp>
+#include <libnova/test_utils.hpp>
+
+#include <gtest/gtest.h>
+
+#ifdef NOVA_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+
+using namespace nova::literals;
+
+namespace {
+
+auto small_segments(std::size_t size = 4) {
+    return std::make_shared<nova::segment_pool>(size);
+}
+
+auto joined(const nova::segmented_buffer& buf) -> std::string {
+    std::string ret;
+    for (const auto& x : buf.segments()) {
+        ret += x.as_string();
+    }
+    return ret;
+}
+
+} // namespace
+
+TEST(SegmentedBuffer, Empty) {
+    auto buf = nova::segmented_buffer{ 10 };
+    EXPECT_TRUE(buf.empty());
+    EXPECT_TRUE(buf.view().empty());
+    EXPECT_EQ(buf.segment_count(), 0);
+    EXPECT_TRUE(std::ranges::empty(buf.segments()));
+}
+
+TEST(SegmentedBuffer, BeyondIntLimit) {
+    constexpr auto max_size = std::uint64_t{ std::numeric_limits<int>::max() } * 4;
+    auto buf = nova::segmented_buffer{ max_size };
+    EXPECT_EQ(buf.max_size(), max_size);
+    EXPECT_EQ(buf.write("Hello"_data), 5);
+}
+
+TEST(SegmentedBuffer, Write) {
+    auto buf = nova::segmented_buffer{ 100, small_segments() };
+    EXPECT_EQ(buf.write("Hello"_data), 5);
+    EXPECT_EQ(buf.write(" Nova"_data), 5);
+
+    EXPECT_EQ(buf.size(), 10);
+    EXPECT_EQ(buf.segment_count(), 3);
+    EXPECT_EQ(buf.view().as_string(), "Hell");
+    EXPECT_EQ(joined(buf), "Hello Nova");
+}
+
+TEST(SegmentedBuffer, WriteToFull) {
+    auto buf = nova::segmented_buffer{ 10, small_segments() };
+    EXPECT_EQ(buf.write("Hello Nova!"_data), 10);
+    EXPECT_EQ(buf.write("a"_data), 0);
+
+    buf.consume(2);
+    EXPECT_EQ(buf.write("abc"_data), 2);
+    EXPECT_EQ(joined(buf), "llo Novaab");
+}
+
+TEST(SegmentedBuffer, Consume) {
+    auto pool = small_segments();
+    auto buf = nova::segmented_buffer{ 100, pool };
+    EXPECT_EQ(buf.write("Hello Nova"_data), 10);
+
+    buf.consume(1);
+    EXPECT_EQ(buf.view().as_string(), "ell");
+
+    buf.consume(6);
+    EXPECT_EQ(buf.view().as_string(), "o");
+    EXPECT_EQ(buf.segment_count(), 2);
+    EXPECT_EQ(pool->cached(), 1);
+    EXPECT_EQ(joined(buf), "ova");
+
+    buf.consume();
+    EXPECT_TRUE(buf.empty());
+    EXPECT_EQ(buf.segment_count(), 1);
+    EXPECT_EQ(pool->cached(), 2);
+
+    // The remaining segment is reused from its beginning.
+    EXPECT_EQ(buf.write("abcdef"_data), 6);
+    EXPECT_EQ(pool->cached(), 1);
+    EXPECT_EQ(joined(buf), "abcdef");
+}
+
+TEST(SegmentedBuffer, SendLoop) {
+    auto buf = nova::segmented_buffer{ 1000, small_segments(7) };
+    const auto data = std::string(100, 'x') + "end";
+    EXPECT_EQ(buf.write(nova::data_view(data)), data.size());
+
+    std::string sent;
+    while (not buf.empty()) {
+        const auto view = buf.view();
+        const auto n = std::min<std::size_t>(view.size(), 5);
+        sent += view.subview(0, n).as_string();
+        buf.consume(n);
+    }
+    EXPECT_EQ(sent, data);
+}
+
+TEST(SegmentedBuffer, SharedPool) {
+    auto pool = small_segments();
+    {
+        auto buf = nova::segmented_buffer{ 100, pool };
+        EXPECT_EQ(buf.write("Hello Nova"_data), 10);
+    }
+    EXPECT_EQ(pool->cached(), 3);
+
+    auto buf = nova::segmented_buffer{ 100, pool };
+    EXPECT_EQ(buf.write("Hello"_data), 5);
+    EXPECT_EQ(pool->cached(), 1);
+}
+
+#ifdef NOVA_LINUX
+
+TEST(SegmentedBuffer, Iovecs) {
+    auto buf = nova::segmented_buffer{ 100, small_segments() };
+    EXPECT_EQ(buf.write("Hello Nova"_data), 10);
+    buf.consume(1);
+
+    auto iov = std::array<iovec, 2>{ };
+    EXPECT_EQ(buf.iovecs(iov), 2);
+    EXPECT_EQ(iov[0].iov_len, 3);
+    EXPECT_EQ(iov[1].iov_len, 4);
+    EXPECT_EQ(nova::data_view(iov[1].iov_base, iov[1].iov_len).as_string(), "o No");
+}
+
+TEST(SegmentedBuffer, FillFromDrainTo) {
+    auto fds = pipe_fds{ O_NONBLOCK };
+
+    auto out = nova::segmented_buffer{ 1'000'000, small_segments(1000) };
+    auto in = nova::segmented_buffer{ 1'000'000, small_segments(1000) };
+    const auto data = std::string(50'000, 'x') + "end";
+
+    EXPECT_EQ(out.write(nova::data_view(data)), data.size());
+    const auto sent = out.drain_to(fds.write);
+    ASSERT_TRUE(sent.has_value());
+    EXPECT_EQ(sent->bytes, data.size());
+    EXPECT_TRUE(out.empty());
+
+    const auto received = in.fill_from(fds.read);
+    ASSERT_TRUE(received.has_value());
+    EXPECT_EQ(received->bytes, data.size());
+    EXPECT_EQ(in.size(), data.size());
+    EXPECT_EQ(in.segment_count(), 51);
+    EXPECT_EQ(joined(in), data);
+
+    EXPECT_EQ(in.fill_from(fds.read)->status, nova::io_status::would_block);
+    EXPECT_EQ(in.segment_count(), 51);
+    EXPECT_EQ(in.write("!"_data), 1);
+    EXPECT_EQ(joined(in), data + "!");
+
+    fds.close_write();
+    EXPECT_EQ(in.fill_from(fds.read)->status, nova::io_status::eof);
+}
+
+TEST(SegmentedBuffer, FillFrom_LimitedSize) {
+    auto fds = pipe_fds{ O_NONBLOCK };
+    ASSERT_EQ(::write(fds.write, "Hello Nova", 10), 10);
+
+    auto buf = nova::segmented_buffer{ 6, small_segments() };
+    EXPECT_EQ(buf.write("a"_data), 1);
+    EXPECT_EQ(buf.fill_from(fds.read)->bytes, 5);
+    EXPECT_EQ(buf.fill_from(fds.read)->bytes, 0);
+    EXPECT_EQ(joined(buf), "aHello");
+
+    buf.consume(3);
+    EXPECT_EQ(buf.fill_from(fds.read)->bytes, 3);
+    EXPECT_EQ(joined(buf), "llo No");
+}
+
+#endif // NOVA_LINUX
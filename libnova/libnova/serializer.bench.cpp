@@ -1,13 +1,16 @@
 #include <libnova/data.hpp>
+#include <libnova/json.hpp>
 #include <libnova/random.hpp>
 #include <libnova/types.hpp>
 
 #include <benchmark/benchmark.h>
+#include <fmt/format.h>
 
 #include <cstdint>
 #include <limits>
-
-constexpr auto ByteArrayLength = 100'000'000;
+#include <span>
+#include <string>
+#include <vector>
 
 template <typename T>
 static void integer(benchmark::State& state) {
@@ -15,7 +18,7 @@ static void integer(benchmark::State& state) {
     auto value = nova::random().number<T>(nova::range<T>{ 1, std::numeric_limits<T>::max() });
 
     for (auto _ : state) {
-        auto ser = nova::serializer_context{ ByteArrayLength };
+        auto ser = nova::serializer_context{ length * sizeof(T) };
         for (std::size_t i = 0; i < length; ++i) {
             ser(value);
         }
@@ -24,12 +27,44 @@ static void integer(benchmark::State& state) {
     }
 }
 
+template <typename T>
+static void integer_array(benchmark::State& state) {
+    const auto length = static_cast<std::size_t>(state.range(0));
+    auto values = std::vector<T>(length);
+    for (auto& x : values) {
+        x = nova::random().number<T>(nova::range<T>{ 1, std::numeric_limits<T>::max() });
+    }
+
+    for (auto _ : state) {
+        auto ser = nova::serializer_context{ length * sizeof(T) };
+        ser(std::span<const T>(values));
+        auto data = ser.data();
+        benchmark::DoNotOptimize(data);
+    }
+}
+
+template <typename T>
+static void integer_reused_context(benchmark::State& state) {
+    const auto length = static_cast<std::size_t>(state.range(0));
+    auto value = nova::random().number<T>(nova::range<T>{ 1, std::numeric_limits<T>::max() });
+    auto ser = nova::serializer_context{ length * sizeof(T) };
+
+    for (auto _ : state) {
+        ser.reset();
+        for (std::size_t i = 0; i < length; ++i) {
+            ser(value);
+        }
+        auto data = ser.view();
+        benchmark::DoNotOptimize(data);
+    }
+}
+
 static void string(benchmark::State& state) {
     const auto length = static_cast<std::size_t>(state.range(0));
     auto value = nova::random().string<nova::ascii_distribution>(1);
 
     for (auto _ : state) {
-        auto ser = nova::serializer_context{ ByteArrayLength };
+        auto ser = nova::serializer_context{ length * value.size() };
         for (std::size_t i = 0; i < length; ++i) {
             ser(value);
         }
@@ -38,10 +73,110 @@ static void string(benchmark::State& state) {
     }
 }
 
+struct order {
+    std::uint32_t id;
+    std::uint64_t price;
+    std::uint32_t quantity;
+};
+
+auto random_orders(std::size_t length) -> std::vector<order> {
+    auto ret = std::vector<order>(length);
+    for (auto& x : ret) {
+        x.id = nova::random().number(nova::range<std::uint32_t>{ 0, std::numeric_limits<std::uint32_t>::max() });
+        x.price = nova::random().number(nova::range<std::uint64_t>{ 0, std::numeric_limits<std::uint64_t>::max() });
+        x.quantity = nova::random().number(nova::range<std::uint32_t>{ 0, 1000 });
+    }
+    return ret;
+}
+
+/**
+ * Length prefix and elements one by one, growing the buffer as needed.
+ */
+static void vector_per_element(benchmark::State& state) {
+    const auto xs = random_orders(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto ser = nova::serializer_context{ };
+        ser(nova::varint{ xs.size() });
+        for (const auto& x : xs) {
+            ser(x);
+        }
+        benchmark::DoNotOptimize(ser.view());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void vector_builtin(benchmark::State& state) {
+    const auto xs = random_orders(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto ser = nova::serializer_context{ };
+        ser(xs);
+        benchmark::DoNotOptimize(ser.view());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void vector_deserialize(benchmark::State& state) {
+    const auto data = nova::serialize(random_orders(static_cast<std::size_t>(state.range(0))));
+
+    for (auto _ : state) {
+        auto xs = nova::deserialize<std::vector<order>>(nova::data_view(data));
+        benchmark::DoNotOptimize(xs);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * About 10 KB of text: an array of records with mixed fields, like a typical
+ * API response or configuration.
+ */
+static auto json_document() -> nova::json {
+    auto text = std::string{ R"({ "source": "bench", "version": 3, "records": [)" };
+    for (int i = 0; i < 96; ++i) {
+        text += fmt::format(
+            R"({}{{ "id": {}, "name": "record-{}", "price": {}, "quantity": {}, "active": {}, "tags": [ "a", "b{}" ], "parent": null }})",
+            i == 0 ? "" : ", ", 100'000 + i * 37, i, 12.5 + i * 0.01, i * 3 - 50, i % 3 == 0, i % 7
+        );
+    }
+    text += "] }";
+    return nova::json(text);
+}
+
+static void json_text_round_trip(benchmark::State& state) {
+    const auto doc = json_document();
+    for (auto _ : state) {
+        auto copy = nova::json(doc.dump());
+        benchmark::DoNotOptimize(copy);
+    }
+    state.counters["bytes"] = static_cast<double>(doc.dump().size());
+}
+
+static void json_cbor_round_trip(benchmark::State& state) {
+    const auto doc = json_document();
+    auto ser = nova::serializer_context{ };
+    for (auto _ : state) {
+        ser.reset();
+        doc.to_cbor(ser);
+        auto copy = nova::json::from_cbor(ser.view());
+        benchmark::DoNotOptimize(copy);
+    }
+    state.counters["bytes"] = static_cast<double>(ser.size());
+}
+
 BENCHMARK(string)->RangeMultiplier(4)->Range(16, 2 << 14);
 BENCHMARK(integer<std::uint8_t>)->RangeMultiplier(4)->Range(16, 2 << 14);
 BENCHMARK(integer<std::uint16_t>)->RangeMultiplier(4)->Range(16, 2 << 14);
 BENCHMARK(integer<std::uint32_t>)->RangeMultiplier(4)->Range(16, 2 << 14);
 BENCHMARK(integer<std::uint64_t>)->RangeMultiplier(4)->Range(16, 2 << 14);
+BENCHMARK(integer_reused_context<std::uint8_t>)->RangeMultiplier(4)->Range(16, 2 << 14);
+BENCHMARK(integer_reused_context<std::uint64_t>)->RangeMultiplier(4)->Range(16, 2 << 14);
+BENCHMARK(integer_array<std::uint8_t>)->RangeMultiplier(4)->Range(16, 2 << 14);
+BENCHMARK(integer_array<std::uint16_t>)->RangeMultiplier(4)->Range(16, 2 << 14);
+BENCHMARK(integer_array<std::uint32_t>)->RangeMultiplier(4)->Range(16, 2 << 14);
+BENCHMARK(integer_array<std::uint64_t>)->RangeMultiplier(4)->Range(16, 2 << 14);
+BENCHMARK(vector_per_element)->RangeMultiplier(4)->Range(16, 2 << 14);
+BENCHMARK(vector_builtin)->RangeMultiplier(4)->Range(16, 2 << 14);
+BENCHMARK(vector_deserialize)->RangeMultiplier(4)->Range(16, 2 << 14);
+BENCHMARK(json_text_round_trip);
+BENCHMARK(json_cbor_round_trip);
 
 BENCHMARK_MAIN();
@@ -6,6 +6,14 @@
 
 #pragma once
 
+#include <libnova/intrinsics.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 namespace nova {
@@ -15,4 +23,32 @@ template <typename Enum>
     return static_cast<std::underlying_type_t<Enum>>(e);
 }
 
+/**
+ * @brief   Reverse the bytes of an integral value.
+ *
+ * Available in C++23 as `std::byteswap`.
+ */
+template <std::integral T>
+[[nodiscard]] constexpr T byteswap(T x) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return x;
+    }
+#if defined(NOVA_GCC) || defined(NOVA_CLANG)
+    else if constexpr (sizeof(T) == 2) {
+        return static_cast<T>(__builtin_bswap16(static_cast<std::uint16_t>(x)));
+    }
+    else if constexpr (sizeof(T) == 4) {
+        return static_cast<T>(__builtin_bswap32(static_cast<std::uint32_t>(x)));
+    }
+    else if constexpr (sizeof(T) == 8) {
+        return static_cast<T>(__builtin_bswap64(static_cast<std::uint64_t>(x)));
+    }
+#endif
+    else {
+        auto repr = std::bit_cast<std::array<std::byte, sizeof(T)>>(x);
+        std::ranges::reverse(repr);
+        return std::bit_cast<T>(repr);
+    }
+}
+
 } // namespace nova
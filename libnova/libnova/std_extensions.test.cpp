@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
 #include <type_traits>
 
 TEST(StdExt, ToUnderlying) {
@@ -9,3 +10,12 @@ TEST(StdExt, ToUnderlying) {
     const auto e = EnumShort::e;
     static_assert(std::is_same_v<short, decltype(nova::to_underlying(e))>);
 }
+
+TEST(StdExt, Byteswap) {
+    static_assert(nova::byteswap(std::uint8_t{ 0x01 }) == 0x01);
+    static_assert(nova::byteswap(std::uint16_t{ 0x0102 }) == 0x0201);
+    static_assert(nova::byteswap(std::uint32_t{ 0x01020304 }) == 0x04030201);
+    static_assert(nova::byteswap(std::uint64_t{ 0x01020304'05060708 }) == 0x08070605'04030201);
+
+    EXPECT_EQ(nova::byteswap(std::int16_t{ 0x00FF }), std::int16_t{ -256 });
+}
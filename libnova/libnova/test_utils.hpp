@@ -7,7 +7,15 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#ifdef NOVA_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <array>
 #include <compare>
+#include <cstddef>
+#include <vector>
 
 #define EXPECT_ASSERTION_FAIL(expr)                                            \
     EXPECT_THAT(                                                               \
@@ -72,3 +80,52 @@ struct nomoo {
 
     int x;
 };
+
+/**
+ * @brief   Deterministic, non-repeating looking bytes.
+ */
+inline auto sample_data(std::size_t size) -> std::vector<unsigned char> {
+    auto ret = std::vector<unsigned char>(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        ret[i] = static_cast<unsigned char>(i * 37 + 11);
+    }
+    return ret;
+}
+
+#ifdef NOVA_LINUX
+
+/**
+ * @brief   Pipe, closed on destruction.
+ */
+struct pipe_fds {
+    int read = -1;
+    int write = -1;
+
+    explicit pipe_fds(int flags = 0) {
+        auto fds = std::array<int, 2>{ };
+        if (pipe2(fds.data(), flags) != 0) {
+            throw nova::exception("Cannot create pipe");
+        }
+        read = fds[0];
+        write = fds[1];
+    }
+
+    pipe_fds(const pipe_fds&) = delete;
+    pipe_fds& operator=(const pipe_fds&) = delete;
+
+    ~pipe_fds() {
+        close_write();
+        if (read != -1) {
+            close(read);
+        }
+    }
+
+    void close_write() {
+        if (write != -1) {
+            close(write);
+            write = -1;
+        }
+    }
+};
+
+#endif // NOVA_LINUX
@@ -9,8 +9,11 @@
 #include <array>
 #include <chrono>
 #include <map>
+#include <span>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -41,6 +44,18 @@ template <typename T> struct is_std_vector : std::false_type {};
 template <typename T> struct is_std_vector<std::vector<T>> : std::true_type {};
 template <typename T> inline constexpr bool is_std_vector_v = is_std_vector<T>::value;
 
+template <typename T>                struct is_std_span : std::false_type {};
+template <typename T, std::size_t N> struct is_std_span<std::span<T, N>> : std::true_type {};
+template <typename T> inline constexpr bool is_std_span_v = is_std_span<T>::value;
+
+template <typename T>     struct is_std_tuple : std::false_type {};
+template <typename... Ts> struct is_std_tuple<std::tuple<Ts...>> : std::true_type {};
+template <typename T> inline constexpr bool is_std_tuple_v = is_std_tuple<T>::value;
+
+template <typename T>               struct is_std_pair : std::false_type {};
+template <typename T1, typename T2> struct is_std_pair<std::pair<T1, T2>> : std::true_type {};
+template <typename T> inline constexpr bool is_std_pair_v = is_std_pair<T>::value;
+
 template <typename T>             struct is_std_map : std::false_type {};
 template <typename K, typename V> struct is_std_map<std::map<K, V>> : std::true_type {};
 template <typename T> inline constexpr bool is_std_map_v = is_std_map<T>::value;